@@ -5,33 +5,42 @@
 #include <functional>
 #include <optional>
 #include <ranges>
+#include <stop_token>
 #include <string>
 
+#include <algorithms/algorithm_options.hpp>
 #include <algorithms/cpop.hpp>
 #include <algorithms/dbca.hpp>
+#include <algorithms/genetic.hpp>
 #include <algorithms/heft.hpp>
+#include <algorithms/lookahead_heft.hpp>
+#include <algorithms/peft.hpp>
 #include <algorithms/rbca.hpp>
 #include <algorithms/tdca.hpp>
 #include <cluster/cluster.hpp>
-#include <io/command_line_arguments.hpp>
+#include <cluster/cost_model.hpp>
 #include <schedule/schedule.hpp>
 #include <workflow/workflow.hpp>
 
 namespace algorithms {
 
 enum class algorithm {
-    HEFT, CPOP, RBCA, DBCA, TDCA
+    HEFT, CPOP, RBCA, DBCA, TDCA, PEFT, LOOKAHEAD_HEFT, GENETIC
 };
 
-std::array<algorithm, 5> constexpr ALL = {
+// the algorithms of a run without a selected algorithm and of the portfolio, the genetic
+// algorithm takes minutes on large workflows and only runs if it is selected
+std::array<algorithm, 7> constexpr ALL = {
     algorithm::HEFT,
     algorithm::CPOP,
     algorithm::RBCA,
     algorithm::DBCA,
-    algorithm::TDCA
+    algorithm::TDCA,
+    algorithm::PEFT,
+    algorithm::LOOKAHEAD_HEFT
 };
 
-std::string to_string(algorithm const algo) {
+inline std::string to_string(algorithm const algo) {
     std::string s;
 
     switch (algo) {
@@ -45,13 +54,19 @@ std::string to_string(algorithm const algo) {
         break;
         case algorithm::TDCA: s = "TDCA";
         break;
+        case algorithm::PEFT: s = "PEFT";
+        break;
+        case algorithm::LOOKAHEAD_HEFT: s = "LOOKAHEAD_HEFT";
+        break;
+        case algorithm::GENETIC: s = "GENETIC";
+        break;
         default: throw std::runtime_error("Internal bug: unknown algorithm.");
     }
 
     return s;
 }
 
-std::optional<algorithm> from_string(std::string const & s) {
+inline std::optional<algorithm> from_string(std::string const & s) {
     auto lower = s | std::views::transform([] (unsigned char const c) {
         return std::tolower(c);
     });
@@ -67,6 +82,12 @@ std::optional<algorithm> from_string(std::string const & s) {
         return algorithm::DBCA;
     } else if (lower_s == "tdca") {
         return algorithm::TDCA;
+    } else if (lower_s == "peft") {
+        return algorithm::PEFT;
+    } else if (lower_s == "lookahead_heft") {
+        return algorithm::LOOKAHEAD_HEFT;
+    } else if (lower_s == "genetic") {
+        return algorithm::GENETIC;
     } else if (lower_s == "none") {
         return std::nullopt;
     }
@@ -74,31 +95,48 @@ std::optional<algorithm> from_string(std::string const & s) {
     throw std::runtime_error("The selected algorithm is unknown or contains a typo.");
 }
 
-std::function<schedule::schedule()> to_function(
+// computes the schedule into s, which must have been constructed for the cluster c, s is reset
+// first and keeps its memory, so a reused schedule doesn't allocate for its intervals again,
+// if a stop is requested, TDCA skips its remaining improvements and returns a complete schedule,
+// all other algorithms return early with a schedule that misses the remaining tasks
+template <cluster::cost_model M>
+void compute_schedule(
     algorithm const algo,
     cluster::cluster const & c,
     workflow::workflow const & w,
-    io::command_line_arguments const & args
+    algorithm_options const & options,
+    schedule::schedule<M> & s,
+    std::stop_token const stop_token = {}
 ) {
     switch (algo) {
-        case algorithm::HEFT: return [&] () {
-            return algorithms::heft(c, w, args);
-        };
-        case algorithm::CPOP: return [&] () {
-            return algorithms::cpop(c, w, args);
-        };
-        case algorithm::RBCA: return [&] () {
-            return algorithms::rbca(c, w, args);
-        };
-        case algorithm::DBCA: return [&] () {
-            return algorithms::dbca(c, w, args);
-        };
-        case algorithm::TDCA: return [&] () {
-            return algorithms::tdca(c, w, args);
-        };
+        case algorithm::HEFT: return algorithms::heft<M>(c, w, options, s, stop_token);
+        case algorithm::CPOP: return algorithms::cpop<M>(c, w, options, s, stop_token);
+        case algorithm::RBCA: return algorithms::rbca<M>(c, w, options, s, stop_token);
+        case algorithm::DBCA: return algorithms::dbca<M>(c, w, options, s, stop_token);
+        case algorithm::TDCA: return algorithms::tdca<M>(c, w, options, s, stop_token);
+        case algorithm::PEFT: return algorithms::peft<M>(c, w, options, s, stop_token);
+        case algorithm::LOOKAHEAD_HEFT: return algorithms::lookahead_heft<M>(c, w, options, s, stop_token);
+        case algorithm::GENETIC: return algorithms::genetic<M>(c, w, options, s, stop_token);
         default:
             throw std::runtime_error("Internal bug: unknown algorithm.");
     }
 }
 
+// the options are copied, the cluster and the workflow must outlive the function
+template <cluster::cost_model M>
+std::function<schedule::schedule<M>()> to_function(
+    algorithm const algo,
+    cluster::cluster const & c,
+    workflow::workflow const & w,
+    algorithm_options const & options,
+    std::stop_token const stop_token = {}
+) {
+    return [algo, &c, &w, options, stop_token] () {
+        schedule::schedule<M> s(c, options.use_memory_requirements);
+        compute_schedule<M>(algo, c, w, options, s, stop_token);
+
+        return s;
+    };
+}
+
 } // namespace algorithms
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <io/command_line_arguments.hpp>
+
+namespace algorithms {
+
+// the part of the command line arguments that the algorithms use, so the library can schedule
+// without building a full set of command line arguments for every call
+struct algorithm_options {
+    bool use_memory_requirements{false};
+
+    // the genetic algorithm stops at whichever limit is reached first, 0 means no limit
+    size_t ga_generations{50};
+    size_t ga_time_ms{0};
+
+    // where the critical path of CPOP and the warnings are written to
+    bool verbose{false};
+    std::string output{};
+};
+
+inline algorithm_options to_algorithm_options(io::command_line_arguments const & args) {
+    return algorithm_options{
+        args.use_memory_requirements,
+        args.ga_generations,
+        args.ga_time_ms,
+        args.verbose,
+        args.output
+    };
+}
+
+} // namespace algorithms
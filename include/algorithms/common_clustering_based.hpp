@@ -7,6 +7,7 @@
 #include <vector>
 
 #include <cluster/cluster.hpp>
+#include <cluster/cost_model.hpp>
 #include <schedule/schedule.hpp>
 #include <workflow/task.hpp>
 #include <workflow/workflow.hpp>
@@ -88,7 +89,7 @@ struct task_group {
 
 // return sequence of <groups> many numbers that add up to <total> 
 // split as evenly as possible (numbers differ by at most one)
-std::vector<size_t> split_most_evenly(size_t const total, size_t const num_groups) {
+inline std::vector<size_t> split_most_evenly(size_t const total, size_t const num_groups) {
     std::vector<size_t> group_sizes(num_groups);
     
     size_t const ratio = total / num_groups;
@@ -103,10 +104,11 @@ std::vector<size_t> split_most_evenly(size_t const total, size_t const num_group
 }
 
 // match most expensive group to best cluster, and so on
+template <cluster::cost_model M>
 void select_good_processors_for_expensive_groups(
     cluster::cluster const & c, 
     workflow::workflow const & w,
-    schedule::schedule & s,
+    schedule::schedule<M> & s,
     std::vector<task_group> & groups,
     [[maybe_unused]] bool const use_memory_requirements
 ) {
@@ -1,38 +1,52 @@
 #pragma once 
 
 #include <algorithm>
-#include <queue>
 #include <ranges>
 #include <sstream>
-#include <unordered_map>
-#include <unordered_set>
+#include <stop_token>
 #include <vector>
 
+#include <algorithms/algorithm_options.hpp>
 #include <cluster/cluster.hpp>
-#include <io/command_line_arguments.hpp>
+#include <cluster/cost_model.hpp>
 #include <io/handle_output.hpp>
 #include <schedule/schedule.hpp>
-#include <util/epsilon_compare.hpp>
+#include <util/d_ary_heap.hpp>
+#include <util/trace.hpp>
 #include <workflow/workflow.hpp>
 
 namespace algorithms {
 
-std::unordered_map<workflow::task_id, double> compute_task_priorities(
-    std::unordered_map<workflow::task_id, double> downward_ranks,
-    std::unordered_map<workflow::task_id, double> upward_ranks
+inline std::vector<double> compute_task_priorities(
+    std::vector<double> const & downward_ranks,
+    std::vector<double> const & upward_ranks
 ) {
-    std::unordered_map<workflow::task_id, double> task_priorities{};
+    std::vector<double> task_priorities(downward_ranks.size());
 
-    for (auto const & [t_id, downward_rank] : downward_ranks) {
-        task_priorities.insert({ t_id, downward_rank + upward_ranks.at(t_id) });
+    for (workflow::task_id t_id = 0; t_id < downward_ranks.size(); ++t_id) {
+        task_priorities[t_id] = downward_ranks[t_id] + upward_ranks[t_id];
     }
 
     return task_priorities;
 }
 
-std::unordered_set<workflow::task_id> compute_critical_path(
+// the tasks of the critical path in path order and as a dense membership bit vector
+struct critical_path {
+    std::vector<workflow::task_id> task_ids;
+    std::vector<bool> contains_task;
+
+    bool contains(workflow::task_id const t_id) const {
+        return contains_task[t_id];
+    }
+};
+
+// the successor that determines the upward rank of a task has the same priority as the task
+// on the critical path, so the path is read off the rank successors exactly without comparing
+// priorities, which avoids misclassified near-ties due to rounding on deep workflows
+inline critical_path compute_critical_path(
     workflow::workflow const & w,
-    std::unordered_map<workflow::task_id, double> task_priorities
+    std::vector<double> const & task_priorities,
+    std::vector<workflow::task_id> const & rank_successors
 ) {
     // we don't enforce a single entry task and choose the independent task with the highest priority
     auto const & independent_task_ids = w.get_independent_task_ids();
@@ -41,8 +55,8 @@ std::unordered_set<workflow::task_id> compute_critical_path(
         [&task_priorities] (workflow::task_id const & t0_id, workflow::task_id const & t1_id) {
             // this should be analogous to the std::less operator regarding priority (t0 < t1?)
             // if the priorities are equal, then t0 has a smaller priority, if its id is larger
-            double const t0_priority = task_priorities.at(t0_id);
-            double const t1_priority = task_priorities.at(t1_id);
+            double const t0_priority = task_priorities[t0_id];
+            double const t1_priority = task_priorities[t1_id];
 
             if (t0_priority == t1_priority) {
                 return t0_id > t1_id;
@@ -51,40 +65,23 @@ std::unordered_set<workflow::task_id> compute_critical_path(
             }
         });
 
-    // safe dereference because it is enforced that independent tasks exist
-    double const critical_path_priority = task_priorities.at(*max_it);
-    workflow::task_id curr_task_id = *max_it;
-
-    std::unordered_set<workflow::task_id> critical_path{};
-    auto const has_critical_priority = [&task_priorities, critical_path_priority] (workflow::task_id const & t_id) {
-        return util::epsilon_eq(task_priorities.at(t_id), critical_path_priority);
-    };
-
-    while (true) {
-        critical_path.insert(curr_task_id);
-
-        auto critical_successor_task_ids = w.get_task_outgoing_edges(curr_task_id)
-            | std::views::transform([] (auto const & edge) {
-                auto const & [neighbor_id, weight] = edge;
-                return neighbor_id;
-            })
-            | std::views::filter(has_critical_priority);
+    critical_path path{{}, std::vector<bool>(w.size(), false)};
 
-        // tie break using lowest id
-        auto const next_it = std::ranges::min_element(critical_successor_task_ids);
-
-        if (next_it == critical_successor_task_ids.end()) {
-            break;
-        }
-
-        curr_task_id = *next_it;
+    // safe dereference because it is enforced that independent tasks exist
+    for (
+        workflow::task_id curr_task_id = *max_it;
+        curr_task_id != workflow::no_task;
+        curr_task_id = rank_successors[curr_task_id]
+    ) {
+        path.task_ids.push_back(curr_task_id);
+        path.contains_task[curr_task_id] = true;
     }
 
-    return critical_path;
+    return path;
 }
 
-cluster::node_id best_fitting_node(
-    std::unordered_set<workflow::task_id> const & critical_path,
+inline cluster::node_id best_fitting_node(
+    critical_path const & path,
     workflow::workflow const & w,
     cluster::cluster const & c,
     bool const use_memory_requirements
@@ -95,7 +92,7 @@ cluster::node_id best_fitting_node(
 
     // in our input model, the critical path is simply scheduled on
     // the best node with sufficient memory if we want to use the memory requirements
-    auto critical_path_memories = critical_path
+    auto critical_path_memories = path.task_ids
         | std::views::transform([&w] (workflow::task_id const & t_id) {
             return w.get_task(t_id).memory_requirement;
         });
@@ -103,14 +100,8 @@ cluster::node_id best_fitting_node(
     return c.best_performance_node(critical_path_memory_requirement);
 }
 
-std::string critical_path_to_string(
-    std::unordered_set<workflow::task_id> const & critical_path
-) {
-    std::vector<workflow::task_id> critical_path_seq(
-        critical_path.begin(),
-        critical_path.end()
-    );
-
+inline std::string critical_path_to_string(critical_path const & path) {
+    std::vector<workflow::task_id> critical_path_seq = path.task_ids;
     std::ranges::sort(critical_path_seq);
 
     std::stringstream out;
@@ -132,88 +123,85 @@ std::string critical_path_to_string(
 
 // tie-breaking for critical path and priority queue: lower id task -> higher priority
 
-schedule::schedule cpop(
+template <cluster::cost_model M>
+void cpop(
     cluster::cluster const & c,
     workflow::workflow const & w,
-    io::command_line_arguments const & args
+    algorithm_options const & options,
+    schedule::schedule<M> & s,
+    std::stop_token const stop_token = {}
 ) {
-    auto const downward_ranks = w.all_downward_ranks(
+    TRACE_ALGORITHM("CPOP");
+    TRACE_PHASE("ranks");
+
+    auto const & downward_ranks = w.all_downward_ranks(
         c.mean_performance(),
         c.mean_bandwidth()
     );
 
-    auto const upward_ranks = w.all_upward_ranks(
+    auto const & [upward_ranks, rank_successors] = w.all_upward_ranks_and_successors(
         c.mean_performance(),
         c.mean_bandwidth()
     );
 
     auto const task_priorities = compute_task_priorities(downward_ranks, upward_ranks);
 
-    auto const critical_path = compute_critical_path(w, task_priorities);
-
-    io::handle_output_str(args, critical_path_to_string(critical_path));
-
-    cluster::node_id const best_node = best_fitting_node(critical_path, w, c, args.use_memory_requirements);
+    TRACE_PHASE("critical path");
+    critical_path const path = compute_critical_path(w, task_priorities, rank_successors);
 
-    schedule::schedule s(c, args.use_memory_requirements);
+    io::handle_output_str(options.verbose, options.output, critical_path_to_string(path));
 
-    struct prioritized_task {
-        // members can't be const because the priority queue needs this to be moveable
-        workflow::task_id id;
-        double priority;
-        bool on_critical_path;
-    };
+    cluster::node_id const best_node = best_fitting_node(path, w, c, options.use_memory_requirements);
 
-    struct task_priority_compare {
-        bool operator() (prioritized_task const & t0, prioritized_task const & t1) const {
-            // this should be analogous to the std::less operator regarding priority (t0 < t1?)
-            // if the priorities are equal, then t0 has a smaller priority, if its id is larger
-            if (t0.priority == t1.priority) {
-                return t0.id > t1.id;
-            }
+    TRACE_PHASE("insertion");
+    s.reset(options.use_memory_requirements);
 
-            else {
-                return t0.priority < t1.priority;
-            }
+    // this should be analogous to the std::less operator regarding priority (t0 < t1?)
+    // if the priorities are equal, then t0 has a smaller priority, if its id is larger
+    auto const task_priority_less = [&task_priorities] (workflow::task_id const t0_id, workflow::task_id const t1_id) {
+        if (task_priorities[t0_id] == task_priorities[t1_id]) {
+            return t0_id > t1_id;
         }
+
+        return task_priorities[t0_id] < task_priorities[t1_id];
     };
 
-    std::priority_queue<prioritized_task, std::vector<prioritized_task>, task_priority_compare> prio_q;
+    // the ready tasks, allocated once for all tasks
+    util::d_ary_heap<4, decltype(task_priority_less)> ready_tasks(w.size(), task_priority_less);
 
     for (workflow::task_id const & t_id : w.get_independent_task_ids()) {
-        prio_q.push({ t_id, task_priorities.at(t_id), critical_path.contains(t_id) });
+        ready_tasks.push(t_id);
     }
 
-    // copy incoming edges locally to modify to identify new independent tasks
-    auto temp_incoming_edges = w.get_all_incoming_edges();
+    // count the unscheduled predecessors of each task to identify new independent tasks
+    auto remaining_in_degrees = w.get_task_in_degrees();
 
-    while (!prio_q.empty()) {
-        auto [curr_t_id, priority, on_critical_path] = prio_q.top();
-        prio_q.pop();
+    while (!ready_tasks.empty()) {
+        if (stop_token.stop_requested()) {
+            break;
+        }
 
-        if (on_critical_path) {
+        workflow::task_id const curr_t_id = ready_tasks.pop();
+
+        TRACE_TASK_SPAN("insert task", curr_t_id);
+
+        if (path.contains(curr_t_id)) {
             s.insert_into_node_schedule(curr_t_id, best_node, w);
         } else {
             s.insert_into_best_eft_node_schedule(curr_t_id, w);
         }
 
         for (auto const & [neighbor_id, weight] : w.get_task_outgoing_edges(curr_t_id)) {
-            size_t const num_erased = temp_incoming_edges.at(neighbor_id).erase(curr_t_id);
-            if (num_erased != 1) {
+            size_t & neighbor_in_degree = remaining_in_degrees[neighbor_id];
+            if (neighbor_in_degree == 0) {
                 throw std::runtime_error("Internal bug: incoming/outgoing edges are out of sync");
             }
 
-            if (temp_incoming_edges.at(neighbor_id).empty()) {
-                prio_q.push({
-                    neighbor_id,
-                    task_priorities.at(neighbor_id),
-                    critical_path.contains(neighbor_id)
-                });
+            if (--neighbor_in_degree == 0) {
+                ready_tasks.push(neighbor_id);
             }
         }
     }
-
-    return s;
 }
 
 } // namespace algorithms
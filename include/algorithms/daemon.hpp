@@ -0,0 +1,445 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <algorithms/algorithm.hpp>
+#include <algorithms/algorithm_options.hpp>
+#include <cluster/cluster.hpp>
+#include <cluster/core_model.hpp>
+#include <cluster/cost_model.hpp>
+#include <io/command_line_arguments.hpp>
+#include <io/export_schedule.hpp>
+#include <io/read_cluster_input.hpp>
+#include <io/read_workflow_input.hpp>
+#include <io/unix_socket.hpp>
+#include <schedule/schedule.hpp>
+#include <util/blocking_queue.hpp>
+#include <util/parallel_for.hpp>
+#include <workflow/workflow.hpp>
+
+namespace algorithms {
+
+// one line of space separated key=value fields, e.g.
+// id=7 algorithm=heft tasks=bags.csv topology=ligo
+// the cluster of the daemon is used if no cluster file is given
+struct daemon_request {
+    std::string id{};
+    std::string algorithm{};
+    std::string cluster_input{};
+    std::string rack_input{};
+    std::string link_input{};
+    std::string task_bag_input{};
+    std::string topology{};
+    std::string dependency_input{};
+    bool use_memory_requirements{false};
+    // without the records, only the header line of the result is sent
+    bool with_records{true};
+};
+
+inline daemon_request parse_daemon_request(std::string_view line) {
+    daemon_request request{};
+    std::istringstream fields{std::string(line)};
+    std::string field{};
+
+    while (fields >> field) {
+        size_t const separator = field.find('=');
+        if (separator == std::string::npos) {
+            throw std::invalid_argument("The request field " + field + " is not of the form key=value.");
+        }
+
+        std::string const key = field.substr(0, separator);
+        std::string value = field.substr(separator + 1);
+
+        if (key == "id") {
+            request.id = std::move(value);
+        } else if (key == "algorithm") {
+            request.algorithm = std::move(value);
+        } else if (key == "cluster") {
+            request.cluster_input = std::move(value);
+        } else if (key == "racks") {
+            request.rack_input = std::move(value);
+        } else if (key == "links") {
+            request.link_input = std::move(value);
+        } else if (key == "tasks") {
+            request.task_bag_input = std::move(value);
+        } else if (key == "topology") {
+            request.topology = std::move(value);
+        } else if (key == "dependencies") {
+            request.dependency_input = std::move(value);
+        } else if (key == "memory") {
+            request.use_memory_requirements = value == "1";
+        } else if (key == "records") {
+            request.with_records = value != "0";
+        } else {
+            throw std::invalid_argument("The request field " + key + " is unknown.");
+        }
+    }
+
+    if (request.algorithm.empty() || request.task_bag_input.empty()) {
+        throw std::invalid_argument("A request needs at least the fields algorithm and tasks.");
+    }
+
+    if (request.cluster_input.empty() && (!request.rack_input.empty() || !request.link_input.empty())) {
+        throw std::invalid_argument("Racks and links can only be given together with a cluster.");
+    }
+
+    return request;
+}
+
+// the loaded inputs by their paths, an entry is replaced as soon as the last modification time of
+// one of its files changes, so changed files don't accumulate, the files are loaded without the
+// lock and concurrent requests for the same entry wait for the same load
+template <typename T>
+class loaded_input_cache {
+    struct entry {
+        std::string last_write_times;
+        std::shared_future<std::shared_ptr<T const>> value;
+    };
+
+    std::mutex mutex{};
+    std::map<std::string, entry> entries{};
+
+public:
+    template <typename Load>
+    std::shared_ptr<T const> get(std::string const & key, std::vector<std::string> const & paths, Load const & load) {
+        std::string const last_write_times = to_last_write_times(paths);
+        std::promise<std::shared_ptr<T const>> promise{};
+        std::shared_future<std::shared_ptr<T const>> value{};
+        bool must_load = false;
+
+        {
+            std::lock_guard<std::mutex> const lock(mutex);
+            entry & e = entries[key];
+
+            if (!e.value.valid() || e.last_write_times != last_write_times) {
+                e = {last_write_times, promise.get_future().share()};
+                must_load = true;
+            }
+
+            value = e.value;
+        }
+
+        if (must_load) {
+            try {
+                promise.set_value(std::make_shared<T const>(load()));
+            } catch (...) {
+                promise.set_exception(std::current_exception());
+
+                // a failed load is tried again by the next request
+                std::lock_guard<std::mutex> const lock(mutex);
+                auto const it = entries.find(key);
+                if (it != entries.end() && it->second.last_write_times == last_write_times) {
+                    entries.erase(it);
+                }
+            }
+        }
+
+        return value.get();
+    }
+
+private:
+    static std::string to_last_write_times(std::vector<std::string> const & paths) {
+        std::stringstream times{};
+
+        for (std::string const & path : paths) {
+            if (!path.empty()) {
+                times << std::filesystem::last_write_time(path).time_since_epoch().count();
+            }
+
+            times << '\n';
+        }
+
+        return times.str();
+    }
+};
+
+// clusters and workflows stay loaded between requests, together with the ranks that every
+// workflow caches itself, a changed input file is loaded again
+class daemon_cache {
+    loaded_input_cache<cluster::cluster> clusters{};
+    loaded_input_cache<workflow::workflow> workflows{};
+
+    std::optional<cluster::core_model> cores;
+
+public:
+    explicit daemon_cache(std::optional<cluster::core_model> const cores_) : cores{cores_} {}
+
+    std::shared_ptr<cluster::cluster const> get_cluster(daemon_request const & request) {
+        std::vector<std::string> const paths{request.cluster_input, request.rack_input, request.link_input};
+
+        return clusters.get(to_key(paths), paths, [&] () {
+            return io::read_cluster_input(
+                request.cluster_input,
+                request.rack_input,
+                request.link_input,
+                cores
+            );
+        });
+    }
+
+    std::shared_ptr<workflow::workflow const> get_workflow(daemon_request const & request) {
+        std::vector<std::string> const paths{request.task_bag_input, request.dependency_input};
+
+        return workflows.get(request.topology + '\n' + to_key(paths), paths, [&] () {
+            io::workflow_input input = io::read_workflow_input(
+                request.task_bag_input,
+                request.topology,
+                request.dependency_input
+            );
+
+            return workflow::workflow(
+                std::move(input.tasks),
+                std::move(input.input_data_sizes),
+                std::move(input.output_data_sizes),
+                std::move(input.dependencies),
+                std::move(input.task_ids_per_bag)
+            );
+        });
+    }
+
+private:
+    static std::string to_key(std::vector<std::string> const & paths) {
+        std::string key{};
+
+        for (std::string const & path : paths) {
+            key += path + '\n';
+        }
+
+        return key;
+    }
+};
+
+// the response framing: a header line, followed by exactly as many csv records
+// (task_id,node_id,start,end,is_duplicate) as the header announces, e.g.
+// result id=7 algorithm=HEFT makespan=12.5 valid=1 microseconds=240 records=2
+// or a single line: error id=7 message=<text>
+inline std::string run_daemon_request(
+    std::string_view const line,
+    daemon_cache & cache,
+    cluster::cluster const & default_cluster,
+    io::command_line_arguments const & args
+) {
+    auto const start = std::chrono::steady_clock::now();
+
+    std::stringstream response{};
+    response << std::setprecision(std::numeric_limits<double>::max_digits10);
+    std::string id{};
+
+    try {
+        daemon_request const request = parse_daemon_request(line);
+        id = request.id;
+
+        std::optional<algorithm> const algo_opt = from_string(request.algorithm);
+        if (!algo_opt) {
+            throw std::invalid_argument("A request needs an algorithm other than none.");
+        }
+
+        std::shared_ptr<cluster::cluster const> const requested_cluster = request.cluster_input.empty()
+            ? nullptr
+            : cache.get_cluster(request);
+        cluster::cluster const & c = requested_cluster ? *requested_cluster : default_cluster;
+        std::shared_ptr<workflow::workflow const> const w = cache.get_workflow(request);
+
+        // the algorithms themselves must not write any output
+        algorithm_options algo_options = to_algorithm_options(args);
+        algo_options.verbose = false;
+        algo_options.output.clear();
+        algo_options.use_memory_requirements = args.use_memory_requirements || request.use_memory_requirements;
+
+        cluster::visit_cost_model(c, [&] <cluster::cost_model M> ([[maybe_unused]] M const & model) {
+            schedule::schedule<M> const s = to_function<M>(algo_opt.value(), c, *w, algo_options)();
+
+            std::string const valid = args.skip_validation ? "-" : (s.is_valid(*w) ? "1" : "0");
+            size_t num_records = 0;
+            std::stringstream records{};
+            records << std::setprecision(std::numeric_limits<double>::max_digits10);
+
+            if (request.with_records) {
+                s.for_each_interval([&] (
+                    workflow::task_id const t_id,
+                    schedule::time_interval const & interval,
+                    bool const is_duplicate
+                ) {
+                    io::write_schedule_record(records, io::export_format::csv, t_id, interval, is_duplicate);
+                    ++num_records;
+                });
+            }
+
+            auto const end = std::chrono::steady_clock::now();
+
+            response << "result id=" << id
+                << " algorithm=" << to_string(algo_opt.value())
+                << " makespan=" << s.get_makespan()
+                << " valid=" << valid
+                << " microseconds=" << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()
+                << " records=" << num_records << '\n'
+                << records.rdbuf();
+        });
+    } catch (std::exception const & e) {
+        // the message must not break the framing
+        std::string message = e.what();
+        std::ranges::replace(message, '\n', ' ');
+
+        response.str({});
+        response.clear();
+        response << "error id=" << id << " message=" << message << '\n';
+    }
+
+    return response.str();
+}
+
+struct daemon_job {
+    std::string line;
+    std::function<void(std::string const &)> respond;
+};
+
+// true for the lines that end a session, all other non-empty lines are scheduling requests
+inline bool is_daemon_command(std::string_view const line, std::string_view const command) {
+    size_t const first = line.find_first_not_of(" \t\r");
+    size_t const last = line.find_last_not_of(" \t\r");
+
+    return first != std::string_view::npos && line.substr(first, last - first + 1) == command;
+}
+
+inline bool is_blank(std::string_view const line) {
+    return line.find_first_not_of(" \t\r") == std::string_view::npos;
+}
+
+// loads the cluster once and answers scheduling requests from the standard input or from the
+// clients of a Unix domain socket until the input ends or a client sends shutdown, the requests
+// are scheduled on a pool of worker threads and every response is sent as soon as it is
+// computed, so the responses of one client may arrive in a different order than its requests
+inline void handle_daemon_execution(
+    io::command_line_arguments const & args,
+    cluster::cluster const & c,
+    std::optional<cluster::core_model> const cores
+) {
+    daemon_cache cache(cores);
+    util::blocking_queue<daemon_job> jobs{};
+    std::mutex cout_mutex{};
+
+    size_t const num_workers = args.daemon_workers == 0
+        ? util::num_worker_threads(std::numeric_limits<size_t>::max(), 1)
+        : args.daemon_workers;
+
+    // jthreads join on destruction after the queue was closed
+    std::vector<std::jthread> workers{};
+    workers.reserve(num_workers);
+
+    for (size_t i = 0; i < num_workers; ++i) {
+        workers.emplace_back([&] () {
+            while (std::optional<daemon_job> job = jobs.pop()) {
+                job->respond(run_daemon_request(job->line, cache, c, args));
+            }
+        });
+    }
+
+    if (args.socket_path.empty()) {
+        auto const respond = [&cout_mutex] (std::string const & response) {
+            std::lock_guard<std::mutex> const lock(cout_mutex);
+            std::cout << response << std::flush;
+        };
+
+        std::string line{};
+        while (std::getline(std::cin, line)) {
+            if (is_daemon_command(line, "quit") || is_daemon_command(line, "shutdown")) {
+                break;
+            }
+
+            if (!is_blank(line)) {
+                jobs.push({std::move(line), respond});
+            }
+        }
+
+        jobs.close();
+        return;
+    }
+
+    struct connection {
+        io::socket_fd socket;
+        std::mutex write_mutex{};
+        std::atomic<bool> finished{false};
+    };
+
+    io::socket_fd const listener = io::listen_unix_socket(args.socket_path);
+    io::wakeup_signal const stop_accepting{};
+    std::atomic<bool> shutting_down{false};
+
+    {
+        // every connection reads its requests on its own thread
+        std::list<std::pair<std::shared_ptr<connection>, std::jthread>> connections{};
+
+        while (!shutting_down) {
+            std::optional<io::socket_fd> client = io::accept_connection(listener, stop_accepting);
+            if (!client) {
+                break;
+            }
+
+            std::erase_if(connections, [] (auto const & entry) {
+                return entry.first->finished.load();
+            });
+
+            auto const conn = std::make_shared<connection>(std::move(client.value()));
+
+            auto const respond = [conn] (std::string const & response) {
+                std::lock_guard<std::mutex> const lock(conn->write_mutex);
+                // a client that closed its connection early doesn't get its responses
+                io::write_all(conn->socket, response);
+            };
+
+            connections.emplace_back(conn, std::jthread([&, conn, respond] () {
+                io::socket_line_reader reader(conn->socket);
+
+                while (std::optional<std::string> line = reader.next_line()) {
+                    if (is_daemon_command(line.value(), "quit")) {
+                        break;
+                    }
+
+                    if (is_daemon_command(line.value(), "shutdown")) {
+                        // stops the accept of the main thread
+                        shutting_down = true;
+                        stop_accepting.wake();
+                        break;
+                    }
+
+                    if (!is_blank(line.value())) {
+                        jobs.push({std::move(line.value()), respond});
+                    }
+                }
+
+                conn->finished = true;
+            }));
+        }
+
+        // the other clients are disconnected, their queued requests are still answered
+        for (auto const & [conn, reader_thread] : connections) {
+            conn->socket.shutdown_read();
+        }
+    }
+
+    jobs.close();
+    std::filesystem::remove(args.socket_path);
+}
+
+} // namespace algorithms
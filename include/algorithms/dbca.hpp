@@ -8,14 +8,16 @@
 #include <ranges>
 #include <set>
 #include <stdexcept>
+#include <stop_token>
 #include <unordered_set>
 #include <vector>
 
+#include <algorithms/algorithm_options.hpp>
 #include <algorithms/common_clustering_based.hpp>
 #include <cluster/cluster.hpp>
-#include <io/command_line_arguments.hpp>
 #include <io/issue_warning.hpp>
 #include <schedule/schedule.hpp>
+#include <util/trace.hpp>
 #include <workflow/task.hpp>
 #include <workflow/workflow.hpp>
 
@@ -85,7 +87,7 @@ public:
     }
 };
 
-std::vector<task_group> dependency_balanced_task_groups(
+inline std::vector<task_group> dependency_balanced_task_groups(
     workflow::workflow const & w,
     std::vector<workflow::task_id> const & bag, 
     size_t const num_cluster_nodes
@@ -184,15 +186,20 @@ std::vector<task_group> dependency_balanced_task_groups(
 // Running time analysis:
 // TODO
 
-schedule::schedule dbca(
+template <cluster::cost_model M>
+void dbca(
     cluster::cluster const & c, 
     workflow::workflow const & w,
-    io::command_line_arguments const & args
+    algorithm_options const & options,
+    schedule::schedule<M> & s,
+    std::stop_token const stop_token = {}
 ) {
-    schedule::schedule s(c, args.use_memory_requirements);
+    TRACE_ALGORITHM("DBCA");
 
-    if (args.use_memory_requirements) {
-        io::issue_warning(args, "Memory requirements not implemented/used for DBCA");
+    s.reset(options.use_memory_requirements);
+
+    if (options.use_memory_requirements) {
+        io::issue_warning(options.verbose, options.output, "Memory requirements not implemented/used for DBCA");
     }
 
     // we use our bags instead of the levels as defined in the original paper
@@ -200,13 +207,16 @@ schedule::schedule dbca(
     auto const & task_ids_per_bag = w.get_task_ids_per_bag();
 
     for (auto const & bag: task_ids_per_bag) {
+        if (stop_token.stop_requested()) {
+            break;
+        }
+
+        TRACE_SPAN("bag", "schedule bag");
         auto groups = dependency_balanced_task_groups(w, bag, c.size());
         select_good_processors_for_expensive_groups(
-            c, w, s, groups, args.use_memory_requirements
+            c, w, s, groups, options.use_memory_requirements
         );
     }
-
-    return s;
 }
 
 }  // namespace algorithms
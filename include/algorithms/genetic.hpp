@@ -0,0 +1,360 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <span>
+#include <stop_token>
+#include <utility>
+#include <vector>
+
+#include <algorithms/algorithm_options.hpp>
+#include <algorithms/cpop.hpp>
+#include <algorithms/heft.hpp>
+#include <algorithms/rbca.hpp>
+#include <cluster/cluster.hpp>
+#include <cluster/cost_model.hpp>
+#include <schedule/assignment_decoder.hpp>
+#include <schedule/schedule.hpp>
+#include <util/parallel_for.hpp>
+#include <util/timepoint.hpp>
+#include <util/trace.hpp>
+#include <workflow/flat_edges.hpp>
+#include <workflow/workflow.hpp>
+
+namespace algorithms {
+
+size_t constexpr ga_population_size = 48;
+size_t constexpr ga_num_elites = 2;
+size_t constexpr ga_max_mutations = 3;
+std::uint64_t constexpr ga_seed = 1;
+
+// a thread should at least create and evaluate this many individuals per generation
+size_t constexpr min_ga_individuals_per_thread = 4;
+
+// all individuals in flat (#individuals x #tasks) matrices, row i is individual i
+class ga_population {
+    size_t num_tasks;
+    std::vector<cluster::node_id> assignments;
+    std::vector<workflow::task_id> insertion_orders;
+    std::vector<util::timepoint> makespans;
+
+public:
+    ga_population(size_t const num_individuals, size_t const num_tasks_)
+        : num_tasks(num_tasks_),
+          assignments(num_individuals * num_tasks_),
+          insertion_orders(num_individuals * num_tasks_),
+          makespans(num_individuals, std::numeric_limits<util::timepoint>::infinity()) {}
+
+    std::span<cluster::node_id> assignment(size_t const i) {
+        return {assignments.data() + i * num_tasks, num_tasks};
+    }
+
+    std::span<cluster::node_id const> assignment(size_t const i) const {
+        return {assignments.data() + i * num_tasks, num_tasks};
+    }
+
+    std::span<workflow::task_id> insertion_order(size_t const i) {
+        return {insertion_orders.data() + i * num_tasks, num_tasks};
+    }
+
+    std::span<workflow::task_id const> insertion_order(size_t const i) const {
+        return {insertion_orders.data() + i * num_tasks, num_tasks};
+    }
+
+    util::timepoint & makespan(size_t const i) {
+        return makespans[i];
+    }
+
+    util::timepoint makespan(size_t const i) const {
+        return makespans[i];
+    }
+
+    // lowest makespan, ties are broken by the lower index
+    size_t best_individual() const {
+        return static_cast<size_t>(std::ranges::min_element(makespans) - makespans.begin());
+    }
+
+    void copy_individual(ga_population const & other, size_t const from, size_t const to) {
+        std::ranges::copy(other.assignment(from), assignment(to).begin());
+        std::ranges::copy(other.insertion_order(from), insertion_order(to).begin());
+        makespans[to] = other.makespans[from];
+    }
+};
+
+// scratch space of one thread, allocated once for the whole run
+template <cluster::cost_model M>
+struct ga_workspace {
+    schedule::assignment_decoder<M> decoder;
+    std::vector<bool> taken;
+    std::vector<size_t> positions;
+};
+
+// the prefix of the first parent followed by the remaining tasks in the order of the second parent,
+// the result is topological if both parents are
+inline void order_crossover(
+    std::span<workflow::task_id const> const first_parent,
+    std::span<workflow::task_id const> const second_parent,
+    std::span<workflow::task_id> const child,
+    size_t const cut,
+    std::vector<bool> & taken
+) {
+    std::fill(taken.begin(), taken.end(), false);
+
+    for (size_t i = 0; i < cut; ++i) {
+        child[i] = first_parent[i];
+        taken[first_parent[i]] = true;
+    }
+
+    size_t next = cut;
+    for (workflow::task_id const t_id : second_parent) {
+        if (!taken[t_id]) {
+            child[next++] = t_id;
+        }
+    }
+}
+
+// moves a task to a random position between its last predecessor and its first successor
+inline void mutate_insertion_order(
+    std::span<workflow::task_id> const order,
+    workflow::flat_edges const & incoming_edges,
+    workflow::flat_edges const & outgoing_edges,
+    std::vector<size_t> & positions,
+    std::mt19937_64 & rng
+) {
+    for (size_t i = 0; i < order.size(); ++i) {
+        positions[order[i]] = i;
+    }
+
+    size_t const from = std::uniform_int_distribution<size_t>(0, order.size() - 1)(rng);
+    workflow::task_id const t_id = order[from];
+
+    size_t lowest = 0;
+    for (size_t i = incoming_edges.begin(t_id); i < incoming_edges.end(t_id); ++i) {
+        lowest = std::max(lowest, positions[incoming_edges.neighbor_ids[i]] + 1);
+    }
+
+    size_t highest = order.size() - 1;
+    for (size_t i = outgoing_edges.begin(t_id); i < outgoing_edges.end(t_id); ++i) {
+        highest = std::min(highest, positions[outgoing_edges.neighbor_ids[i]] - 1);
+    }
+
+    size_t const to = std::uniform_int_distribution<size_t>(lowest, highest)(rng);
+
+    if (to < from) {
+        std::rotate(order.begin() + to, order.begin() + from, order.begin() + from + 1);
+    } else {
+        std::rotate(order.begin() + from, order.begin() + from + 1, order.begin() + to + 1);
+    }
+}
+
+// Genetic algorithm
+
+// Running time analysis:
+// input: cluster C, workflow-DAG W = (V,E)
+// HEFT + CPOP + RBCA for the seeds
+// + O(#generations * population size * (|V| * |C| + |E|)) for the decoding, in parallel
+
+// an individual is a task to node assignment together with a topological insertion order,
+// it is decoded by inserting the tasks in this order into the gaps of their nodes as for
+// from_assignment, the initial population consists of the HEFT, CPOP and RBCA schedules and
+// mutations of them, the individuals of every generation are created and evaluated in parallel
+// with a random generator per individual, so the result doesn't depend on the number of threads
+
+template <cluster::cost_model M>
+void genetic(
+    cluster::cluster const & c,
+    workflow::workflow const & w,
+    algorithm_options const & options,
+    schedule::schedule<M> & s,
+    std::stop_token const stop_token = {}
+) {
+    TRACE_ALGORITHM("GENETIC");
+    auto const start_time = std::chrono::steady_clock::now();
+
+    TRACE_PHASE("seeds");
+    std::vector<schedule::schedule<M>> seeds{};
+    for (auto const seed_algorithm : {&heft<M>, &cpop<M>, &rbca<M>}) {
+        schedule::schedule<M> seed_sched(c, options.use_memory_requirements);
+        seed_algorithm(c, w, options, seed_sched, stop_token);
+
+        if (seed_sched.is_complete(w)) {
+            seeds.push_back(std::move(seed_sched));
+        }
+    }
+
+    if (seeds.empty()) {
+        // stopped before any seed was complete
+        heft<M>(c, w, options, s, stop_token);
+        return;
+    }
+
+    TRACE_PHASE("initial population");
+    size_t const num_tasks = w.size();
+    size_t const num_nodes = c.size();
+    workflow::flat_edges const incoming_edges = workflow::flatten_incoming_edges(w);
+    workflow::flat_edges const outgoing_edges = workflow::flatten_outgoing_edges(w);
+
+    std::vector<std::vector<cluster::node_id>> fitting_nodes(num_tasks);
+    for (workflow::task_id t_id = 0; t_id < num_tasks; ++t_id) {
+        for (cluster::cluster_node const & node : c) {
+            if (!options.use_memory_requirements || node.memory >= w.get_task(t_id).memory_requirement) {
+                fitting_nodes[t_id].push_back(node.id);
+            }
+        }
+    }
+
+    size_t const num_threads = util::num_worker_threads(ga_population_size, min_ga_individuals_per_thread);
+    std::vector<ga_workspace<M>> workspaces{};
+    for (size_t i = 0; i < num_threads; ++i) {
+        workspaces.push_back({
+            schedule::assignment_decoder<M>(c, w),
+            std::vector<bool>(num_tasks),
+            std::vector<size_t>(num_tasks)
+        });
+    }
+
+    auto const individual_rng = [] (size_t const generation, size_t const individual) {
+        std::seed_seq seq{ga_seed, static_cast<std::uint64_t>(generation), static_cast<std::uint64_t>(individual)};
+        return std::mt19937_64(seq);
+    };
+
+    auto const mutate = [&] (ga_population & pop, size_t const i, std::mt19937_64 & rng, ga_workspace<M> & ws) {
+        size_t const num_mutations = std::uniform_int_distribution<size_t>(1, ga_max_mutations)(rng);
+        auto const assignment = pop.assignment(i);
+
+        for (size_t m = 0; m < num_mutations; ++m) {
+            workflow::task_id const t_id = std::uniform_int_distribution<size_t>(0, num_tasks - 1)(rng);
+            auto const & nodes = fitting_nodes[t_id];
+            assignment[t_id] = nodes[std::uniform_int_distribution<size_t>(0, nodes.size() - 1)(rng)];
+
+            mutate_insertion_order(pop.insertion_order(i), incoming_edges, outgoing_edges, ws.positions, rng);
+        }
+    };
+
+    auto const evaluate = [] (ga_population & pop, size_t const i, ga_workspace<M> & ws) {
+        pop.makespan(i) = ws.decoder.makespan(pop.assignment(i), pop.insertion_order(i), {});
+    };
+
+    ga_population population(ga_population_size, num_tasks);
+    ga_population offspring(ga_population_size, num_tasks);
+
+    // the seeds are kept unchanged, the rest of the population are mutated copies of them
+    for (size_t i = 0; i < ga_population_size; ++i) {
+        schedule::schedule<M> const & seed_sched = seeds[i % seeds.size()];
+        std::ranges::copy(seed_sched.get_task_assignment(w), population.assignment(i).begin());
+        std::ranges::copy(seed_sched.get_task_start_order(w), population.insertion_order(i).begin());
+    }
+
+    util::parallel_for_chunks(ga_population_size, num_threads,
+        [&] (size_t const chunk_id, size_t const begin, size_t const end) {
+            for (size_t i = begin; i < end; ++i) {
+                if (i >= seeds.size() && num_nodes > 1) {
+                    std::mt19937_64 rng = individual_rng(0, i);
+                    mutate(population, i, rng, workspaces[chunk_id]);
+                }
+
+                evaluate(population, i, workspaces[chunk_id]);
+            }
+        }
+    );
+
+    auto const deadline = start_time + std::chrono::milliseconds(options.ga_time_ms);
+    TRACE_PHASE("generations");
+
+    for (size_t generation = 1; ; ++generation) {
+        if (options.ga_generations != 0 && generation > options.ga_generations) {
+            break;
+        }
+
+        if (options.ga_generations == 0 && options.ga_time_ms == 0) {
+            break;
+        }
+
+        if (
+            stop_token.stop_requested()
+            || (options.ga_time_ms != 0 && std::chrono::steady_clock::now() >= deadline)
+        ) {
+            break;
+        }
+
+        TRACE_SPAN("generation", "generation");
+
+        // the elites survive unchanged
+        std::vector<size_t> ranking(ga_population_size);
+        std::iota(ranking.begin(), ranking.end(), 0);
+        std::ranges::stable_sort(ranking, {}, [&population] (size_t const i) {
+            return population.makespan(i);
+        });
+
+        for (size_t e = 0; e < ga_num_elites; ++e) {
+            offspring.copy_individual(population, ranking[e], e);
+        }
+
+        util::parallel_for_chunks(ga_population_size - ga_num_elites, num_threads,
+            [&] (size_t const chunk_id, size_t const begin, size_t const end) {
+                ga_workspace<M> & ws = workspaces[chunk_id];
+
+                for (size_t i = ga_num_elites + begin; i < ga_num_elites + end; ++i) {
+                    std::mt19937_64 rng = individual_rng(generation, i);
+                    std::uniform_int_distribution<size_t> individual_dist(0, ga_population_size - 1);
+
+                    // binary tournaments
+                    auto const select = [&] () {
+                        size_t const a = individual_dist(rng);
+                        size_t const b = individual_dist(rng);
+                        return population.makespan(b) < population.makespan(a) ? b : a;
+                    };
+
+                    size_t const first_parent = select();
+                    size_t const second_parent = select();
+
+                    // two point crossover of the assignments
+                    std::uniform_int_distribution<size_t> cut_dist(0, num_tasks);
+                    size_t cut0 = cut_dist(rng);
+                    size_t cut1 = cut_dist(rng);
+                    if (cut0 > cut1) {
+                        std::swap(cut0, cut1);
+                    }
+
+                    auto const child_assignment = offspring.assignment(i);
+                    std::ranges::copy(population.assignment(first_parent), child_assignment.begin());
+                    std::copy(
+                        population.assignment(second_parent).begin() + cut0,
+                        population.assignment(second_parent).begin() + cut1,
+                        child_assignment.begin() + cut0
+                    );
+
+                    order_crossover(
+                        population.insertion_order(first_parent),
+                        population.insertion_order(second_parent),
+                        offspring.insertion_order(i),
+                        cut_dist(rng),
+                        ws.taken
+                    );
+
+                    if (num_nodes > 1) {
+                        mutate(offspring, i, rng, ws);
+                    }
+
+                    evaluate(offspring, i, ws);
+                }
+            }
+        );
+
+        std::swap(population, offspring);
+    }
+
+    size_t const best = population.best_individual();
+    auto const best_assignment = population.assignment(best);
+
+    s.reset(options.use_memory_requirements);
+    for (workflow::task_id const t_id : population.insertion_order(best)) {
+        s.insert_into_node_schedule(t_id, best_assignment[t_id], w);
+    }
+}
+
+} // namespace algorithms
@@ -8,27 +8,31 @@
 #include <tuple>
 
 #include <algorithms/algorithm.hpp>
+#include <algorithms/algorithm_options.hpp>
 #include <cluster/cluster.hpp>
+#include <cluster/cost_model.hpp>
 #include <io/command_line_arguments.hpp>
 #include <io/handle_output.hpp>
+#include <io/parse_schedule_delta.hpp>
+#include <schedule/local_search.hpp>
+#include <schedule/repair.hpp>
 #include <schedule/schedule.hpp>
 #include <workflow/workflow.hpp>
 
 namespace algorithms {
 // measures CPU time in clocks
-std::tuple<schedule::schedule, std::clock_t> measure_execution(
-    std::function<schedule::schedule()> const & func
+template <cluster::cost_model M>
+std::tuple<schedule::schedule<M>, std::clock_t> measure_execution(
+    std::function<schedule::schedule<M>()> const & func
 ) {
     std::clock_t const start = std::clock();
-    schedule::schedule const s = func();
+    schedule::schedule<M> const s = func();
     std::clock_t const end = std::clock();
 
     return std::make_tuple(s, end - start);
 }
 
-std::string format_clocks(std::clock_t const clocks) {
-    double const seconds = static_cast<double>(clocks) / static_cast<double>(CLOCKS_PER_SEC);
-    
+inline std::string format_seconds(double const seconds) {
     std::stringstream out{};
     out << std::fixed << std::setprecision(2);
 
@@ -43,25 +47,96 @@ std::string format_clocks(std::clock_t const clocks) {
     return out.str();
 }
 
-void handle_execution(
-    algorithm const algo,
+inline std::string format_clocks(std::clock_t const clocks) {
+    return format_seconds(static_cast<double>(clocks) / static_cast<double>(CLOCKS_PER_SEC));
+}
+
+// improves the computed schedule by a local search if a budget for it was given
+template <cluster::cost_model M>
+void handle_improvement(
+    std::string const & algo_str,
     io::command_line_arguments const & args,
     cluster::cluster const & c,
-    workflow::workflow const & w
+    workflow::workflow const & w,
+    schedule::schedule<M> const & sched
 ) {
-    auto const func = algorithms::to_function(
-        algo, c, w, args
-    );
+    if (args.improve_time_ms == 0 && args.improve_iterations == 0) {
+        return;
+    }
 
-    auto const [sched, cpu_time_clocks] = measure_execution(func);
+    schedule::local_search_budget const budget{args.improve_time_ms, args.improve_iterations};
+
+    std::clock_t const start = std::clock();
+    schedule::schedule<M> const improved = schedule::improve_by_local_search(
+        sched, c, w, args.use_memory_requirements, budget
+    );
+    std::clock_t const end = std::clock();
 
     io::handle_computed_schedule_output(
-        algorithms::to_string(algo),
-        format_clocks(cpu_time_clocks),
+        algo_str + "_IMPROVED",
+        format_clocks(end - start),
         args,
-        sched,
+        improved,
         w
     );
 }
 
+// repairs a copy of the computed schedule for a failed node, updated workloads and added
+// dependencies if any were given, the repaired schedule is validated against the changed workflow
+template <cluster::cost_model M>
+void handle_repair(
+    std::string const & algo_str,
+    io::command_line_arguments const & args,
+    workflow::workflow const & w,
+    schedule::schedule<M> const & sched
+) {
+    if (!io::has_schedule_delta(args) || !sched.is_complete(w)) {
+        return;
+    }
+
+    schedule::schedule_delta const delta = io::parse_schedule_delta(args, w.size());
+    workflow::workflow changed_w = w;
+    schedule::schedule<M> repaired = sched;
+
+    std::clock_t const start = std::clock();
+    schedule::apply_delta(changed_w, delta);
+    schedule::repair_schedule(repaired, changed_w, delta);
+    std::clock_t const end = std::clock();
+
+    io::handle_computed_schedule_output(
+        algo_str + "_REPAIRED",
+        format_clocks(end - start),
+        args,
+        repaired,
+        changed_w
+    );
+}
+
+inline void handle_execution(
+    algorithm const algo,
+    io::command_line_arguments const & args,
+    cluster::cluster const & c,
+    workflow::workflow const & w
+) {
+    // the cost model is chosen once per run, the algorithms are instantiated for each of them
+    cluster::visit_cost_model(c, [&] <cluster::cost_model M> ([[maybe_unused]] M const & model) {
+        auto const func = algorithms::to_function<M>(
+            algo, c, w, to_algorithm_options(args)
+        );
+
+        auto const [sched, cpu_time_clocks] = measure_execution(func);
+
+        io::handle_computed_schedule_output(
+            algorithms::to_string(algo),
+            format_clocks(cpu_time_clocks),
+            args,
+            sched,
+            w
+        );
+
+        handle_improvement(algorithms::to_string(algo), args, c, w, sched);
+        handle_repair(algorithms::to_string(algo), args, w, sched);
+    });
+}
+
 } // namespace algorithms
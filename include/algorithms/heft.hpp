@@ -1,29 +1,23 @@
 #pragma once
 
-#include <algorithm>
-#include <numeric>
+#include <stop_token>
 #include <vector>
 
+#include <algorithms/algorithm_options.hpp>
 #include <cluster/cluster.hpp>
-#include <io/command_line_arguments.hpp>
+#include <cluster/cost_model.hpp>
 #include <schedule/schedule.hpp>
+#include <util/sort_by_key.hpp>
+#include <util/trace.hpp>
 #include <workflow/workflow.hpp>
 
 namespace algorithms {
 
-std::vector<workflow::task_id> task_ids_sorted_by_upward_ranks(
-    std::unordered_map<size_t, double> const & upward_ranks
+// ties are broken by the lower id
+inline std::vector<workflow::task_id> task_ids_sorted_by_upward_ranks(
+    std::vector<double> const & upward_ranks
 ) {
-    std::vector<workflow::task_id> priority_list(upward_ranks.size());
-    std::iota(priority_list.begin(), priority_list.end(), 0);
-
-    std::ranges::sort(priority_list, 
-        [&upward_ranks] (workflow::task_id const & t_id0, workflow::task_id const & t_id1) {
-            return upward_ranks.at(t_id0) > upward_ranks.at(t_id1);
-        }
-    );
-
-    return priority_list;
+    return util::ids_sorted_by_key(upward_ranks, true);
 }
 
 // Heterogenous earliest finish time
@@ -34,24 +28,36 @@ std::vector<workflow::task_id> task_ids_sorted_by_upward_ranks(
 // this implementation is in some cases asymptotically slower than the suggested
 // running time in the original paper which is O(|E| * |C|)
 
-schedule::schedule heft(
+template <cluster::cost_model M>
+void heft(
     cluster::cluster const & c, 
     workflow::workflow const & w,
-    io::command_line_arguments const & args
+    algorithm_options const & options,
+    schedule::schedule<M> & s,
+    std::stop_token const stop_token = {}
 ) {
-    auto const upward_ranks = w.all_upward_ranks(
+    TRACE_ALGORITHM("HEFT");
+    TRACE_PHASE("upward ranks");
+
+    auto const & upward_ranks = w.all_upward_ranks(
         c.mean_performance(),
         c.mean_bandwidth()
     );
 
+    TRACE_PHASE("priority list");
     std::vector<size_t> const priority_list = task_ids_sorted_by_upward_ranks(upward_ranks);
-    schedule::schedule s(c, args.use_memory_requirements);
+    s.reset(options.use_memory_requirements);
+
+    TRACE_PHASE("insertion");
 
     for (workflow::task_id const t_id : priority_list) {
+        if (stop_token.stop_requested()) {
+            break;
+        }
+
+        TRACE_TASK_SPAN("insert task", t_id);
         s.insert_into_best_eft_node_schedule(t_id, w);
     }
-    
-    return s;
 }
 
 } // namespace algorithms
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <stop_token>
+#include <vector>
+
+#include <algorithms/algorithm_options.hpp>
+#include <algorithms/heft.hpp>
+#include <cluster/cluster.hpp>
+#include <cluster/cost_model.hpp>
+#include <schedule/schedule.hpp>
+#include <util/parallel_for.hpp>
+#include <util/timepoint.hpp>
+#include <util/trace.hpp>
+#include <workflow/workflow.hpp>
+
+namespace algorithms {
+
+// the lookahead is bounded to this many candidate nodes (best EFT first) per task
+// and this many children (highest upward rank first) per candidate node
+size_t constexpr lookahead_num_candidates = 4;
+size_t constexpr lookahead_num_children = 2;
+
+// a thread should at least do this many EFT evaluations for the children
+size_t constexpr min_lookahead_evaluations_per_thread = 4096;
+
+// highest upward rank first, ties are broken by the lower id
+inline std::vector<workflow::task_id> highest_ranked_children(
+    workflow::workflow const & w,
+    std::vector<double> const & upward_ranks,
+    workflow::task_id const t_id
+) {
+    std::vector<workflow::task_id> children;
+    for (auto const & [child_id, data_transfer] : w.get_task_outgoing_edges(t_id)) {
+        children.push_back(child_id);
+    }
+
+    auto const higher_rank = [&upward_ranks] (workflow::task_id const t0, workflow::task_id const t1) {
+        if (upward_ranks[t0] == upward_ranks[t1]) {
+            return t0 < t1;
+        }
+
+        return upward_ranks[t0] > upward_ranks[t1];
+    };
+
+    size_t const num_children = std::min(children.size(), lookahead_num_children);
+    std::partial_sort(children.begin(), children.begin() + num_children, children.end(), higher_rank);
+    children.resize(num_children);
+
+    return children;
+}
+
+// Heterogenous earliest finish time with lookahead
+
+// Running time analysis:
+// input: cluster C, workflow-DAG W = (V,E)
+// HEFT + O(|V| * lookahead_num_children * max in-degree * |C|) for the ready times of the children
+// + O(|V| * lookahead_num_candidates * lookahead_num_children * |C|) EFT evaluations
+
+// for every task, the best candidate nodes by EFT are tentatively used, then the children
+// of the task are placed virtually on their best nodes and the node with the smallest maximum
+// children EFT is chosen, the candidates are evaluated in parallel on per-thread schedule replicas
+
+template <cluster::cost_model M>
+void lookahead_heft(
+    cluster::cluster const & c,
+    workflow::workflow const & w,
+    algorithm_options const & options,
+    schedule::schedule<M> & s,
+    std::stop_token const stop_token = {}
+) {
+    TRACE_ALGORITHM("LOOKAHEAD_HEFT");
+    TRACE_PHASE("upward ranks");
+
+    auto const & upward_ranks = w.all_upward_ranks(
+        c.mean_performance(),
+        c.mean_bandwidth()
+    );
+
+    TRACE_PHASE("priority list");
+    std::vector<workflow::task_id> const priority_list = task_ids_sorted_by_upward_ranks(upward_ranks);
+
+    TRACE_PHASE("insertion");
+    M const model(c);
+    size_t const num_nodes = c.size();
+
+    size_t const num_threads = std::min(
+        util::num_worker_threads(
+            num_nodes * lookahead_num_candidates * lookahead_num_children,
+            min_lookahead_evaluations_per_thread
+        ),
+        lookahead_num_candidates
+    );
+
+    // every thread has its own replica, the one of the first thread is s,
+    // all replicas receive the same final insertions
+    s.reset(options.use_memory_requirements);
+    std::vector<schedule::schedule<M>> other_replicas(num_threads - 1, s);
+    auto const replica_of_thread = [&s, &other_replicas] (size_t const chunk_id) -> schedule::schedule<M> & {
+        return chunk_id == 0 ? s : other_replicas[chunk_id - 1];
+    };
+
+    // flat row-major (#children x #nodes) scratch matrix, the time at which the data of all already
+    // scheduled predecessors of a looked ahead child is available on a node, refilled for every task
+    std::vector<util::timepoint> children_ready_times(lookahead_num_children * num_nodes);
+
+    auto const fits_into_memory = [&c, &w, &options] (workflow::task_id const t_id, cluster::node_id const n_id) {
+        return !options.use_memory_requirements
+            || (c.begin() + n_id)->memory >= w.get_task(t_id).memory_requirement;
+    };
+
+    struct candidate {
+        cluster::node_id n_id;
+        util::timepoint eft;
+        util::timepoint lookahead_eft;
+    };
+
+    std::vector<candidate> candidates;
+    candidates.reserve(num_nodes);
+
+    for (workflow::task_id const t_id : priority_list) {
+        if (stop_token.stop_requested()) {
+            break;
+        }
+
+        TRACE_TASK_SPAN("insert task", t_id);
+        candidates.clear();
+
+        for (cluster::node_id n_id = 0; n_id < num_nodes; ++n_id) {
+            if (fits_into_memory(t_id, n_id)) {
+                candidates.push_back({n_id, s.earliest_finish_time(t_id, w, n_id), 0.0});
+            }
+        }
+
+        if (candidates.empty()) {
+            throw std::logic_error(
+                "There exists a task with a memory requirement larger than the memory of each node."
+            );
+        }
+
+        size_t const num_candidates = std::min(candidates.size(), lookahead_num_candidates);
+        std::partial_sort(candidates.begin(), candidates.begin() + num_candidates, candidates.end(),
+            [] (candidate const & c0, candidate const & c1) {
+                return c0.eft == c1.eft ? c0.n_id < c1.n_id : c0.eft < c1.eft;
+            }
+        );
+
+        auto const children = highest_ranked_children(w, upward_ranks, t_id);
+        auto const & outgoing_edges = w.get_task_outgoing_edges(t_id);
+
+        // read-only for the threads below, lookahead doesn't duplicate, so a scheduled
+        // predecessor has exactly one interval
+        for (size_t i = 0; i < children.size(); ++i) {
+            util::timepoint * const ready_row = children_ready_times.data() + i * num_nodes;
+            std::fill(ready_row, ready_row + num_nodes, 0.0);
+
+            for (auto const & [pred_id, data_transfer] : w.get_task_incoming_edges(children[i])) {
+                if (!s.is_scheduled(pred_id)) {
+                    continue;
+                }
+
+                schedule::time_interval const & pred_interval = s.get_task_intervals(pred_id).front();
+
+                for (cluster::node_id n_id = 0; n_id < num_nodes; ++n_id) {
+                    ready_row[n_id] = std::max(
+                        ready_row[n_id],
+                        pred_interval.end + model.data_transfer_cost(data_transfer, pred_interval.node_id, n_id)
+                    );
+                }
+            }
+        }
+
+        util::parallel_for_chunks(num_candidates, std::min(num_threads, num_candidates),
+            [&] (size_t const chunk_id, size_t const begin, size_t const end) {
+                schedule::schedule<M> & replica = replica_of_thread(chunk_id);
+
+                for (size_t i = begin; i < end; ++i) {
+                    candidate & cand = candidates[i];
+
+                    if (children.empty()) {
+                        cand.lookahead_eft = cand.eft;
+                        continue;
+                    }
+
+                    replica.begin_tentative_insertions();
+                    replica.insert_into_node_schedule(t_id, cand.n_id, w);
+
+                    util::timepoint max_child_eft = 0.0;
+                    for (size_t child_index = 0; child_index < children.size(); ++child_index) {
+                        workflow::task_id const child_id = children[child_index];
+                        double const data_transfer = outgoing_edges.at(child_id);
+                        double const workload = w.get_task(child_id).workload;
+                        util::timepoint const * const ready_row = 
+                            children_ready_times.data() + child_index * num_nodes;
+
+                        util::timepoint best_child_eft = std::numeric_limits<util::timepoint>::infinity();
+
+                        for (cluster::node_id n_id = 0; n_id < num_nodes; ++n_id) {
+                            if (!fits_into_memory(child_id, n_id)) {
+                                continue;
+                            }
+
+                            util::timepoint const ready_time = std::max(
+                                ready_row[n_id],
+                                cand.eft + model.data_transfer_cost(data_transfer, cand.n_id, n_id)
+                            );
+
+                            best_child_eft = std::min(
+                                best_child_eft,
+                                replica.earliest_finish_time(
+                                    n_id, 
+                                    ready_time, 
+                                    model.computation_time(workload, n_id)
+                                )
+                            );
+                        }
+
+                        max_child_eft = std::max(max_child_eft, best_child_eft);
+                    }
+
+                    replica.rollback_tentative_insertions();
+                    cand.lookahead_eft = max_child_eft;
+                }
+            }
+        );
+
+        // the candidates are sorted by EFT and node id, so ties keep the better EFT
+        auto const best_it = std::min_element(candidates.begin(), candidates.begin() + num_candidates,
+            [] (candidate const & c0, candidate const & c1) {
+                return c0.lookahead_eft < c1.lookahead_eft;
+            }
+        );
+
+        s.insert_into_node_schedule(t_id, best_it->n_id, w);
+        for (schedule::schedule<M> & replica : other_replicas) {
+            replica.insert_into_node_schedule(t_id, best_it->n_id, w);
+        }
+    }
+}
+
+} // namespace algorithms
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <algorithm>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <algorithms/algorithm_options.hpp>
+#include <algorithms/handle_execution.hpp>
+#include <cluster/cluster.hpp>
+#include <cluster/cost_model.hpp>
+#include <io/command_line_arguments.hpp>
+#include <io/handle_output.hpp>
+#include <io/read_csv.hpp>
+#include <io/read_workflow_input.hpp>
+#include <schedule/schedule.hpp>
+#include <util/timepoint.hpp>
+#include <workflow/task.hpp>
+#include <workflow/task_dependency.hpp>
+#include <workflow/workflow.hpp>
+
+namespace algorithms {
+
+// several workflows as one workflow without edges between them, the tasks of workflow k have the
+// global ids [first_task_ids[k], first_task_ids[k + 1]), so all per task data stays in flat vectors
+struct multi_workflow {
+    workflow::workflow w;
+    std::vector<workflow::task_id> first_task_ids;
+    std::vector<size_t> workflow_of_task;
+    // per workflow
+    std::vector<util::timepoint> release_times;
+    std::vector<double> priorities;
+
+    size_t num_workflows() const {
+        return first_task_ids.size() - 1;
+    }
+};
+
+inline multi_workflow read_multi_workflow(std::vector<io::workflow_list_entry> const & entries) {
+    io::workflow_input merged{};
+    std::vector<workflow::task_id> first_task_ids{0};
+    std::vector<size_t> workflow_of_task{};
+    std::vector<util::timepoint> release_times{};
+    std::vector<double> priorities{};
+
+    for (size_t k = 0; k < entries.size(); ++k) {
+        io::workflow_list_entry const & entry = entries[k];
+        io::workflow_input const input = io::read_workflow_input(
+            entry.task_bag_input,
+            entry.topology,
+            entry.dependency_input
+        );
+
+        workflow::task_id const offset = first_task_ids.back();
+
+        for (workflow::task const & t : input.tasks) {
+            merged.tasks.emplace_back(offset + t.id, t.workload, t.memory_requirement);
+        }
+
+        merged.input_data_sizes.insert(
+            merged.input_data_sizes.end(), input.input_data_sizes.begin(), input.input_data_sizes.end()
+        );
+        merged.output_data_sizes.insert(
+            merged.output_data_sizes.end(), input.output_data_sizes.begin(), input.output_data_sizes.end()
+        );
+
+        for (workflow::task_dependency const & dep : input.dependencies) {
+            merged.dependencies.emplace_back(offset + dep.from_id, offset + dep.to_id);
+        }
+
+        for (auto const & bag_ids : input.task_ids_per_bag) {
+            auto & merged_bag_ids = merged.task_ids_per_bag.emplace_back();
+
+            for (workflow::task_id const t_id : bag_ids) {
+                merged_bag_ids.push_back(offset + t_id);
+            }
+        }
+
+        first_task_ids.push_back(offset + input.tasks.size());
+        workflow_of_task.insert(workflow_of_task.end(), input.tasks.size(), k);
+        release_times.push_back(entry.release_time);
+        priorities.push_back(entry.priority);
+    }
+
+    return multi_workflow{
+        workflow::workflow(
+            std::move(merged.tasks),
+            std::move(merged.input_data_sizes),
+            std::move(merged.output_data_sizes),
+            std::move(merged.dependencies),
+            std::move(merged.task_ids_per_bag)
+        ),
+        std::move(first_task_ids),
+        std::move(workflow_of_task),
+        std::move(release_times),
+        std::move(priorities)
+    };
+}
+
+// HEFT with one priority list over all workflows
+
+// Running time analysis:
+// same as HEFT for the union of all workflows
+
+// the tasks are sorted by the priority of their workflow (higher first) and then by upward rank,
+// ties are broken by the lower global id, no task starts before the release time of its workflow,
+// the insertion policy lets later tasks fill the gaps that earlier released workflows left
+template <cluster::cost_model M>
+schedule::schedule<M> multi_workflow_heft(
+    cluster::cluster const & c,
+    multi_workflow const & mw,
+    algorithm_options const & options
+) {
+    auto const & upward_ranks = mw.w.all_upward_ranks(
+        c.mean_performance(),
+        c.mean_bandwidth()
+    );
+
+    std::vector<workflow::task_id> priority_list(mw.w.size());
+    std::iota(priority_list.begin(), priority_list.end(), 0);
+
+    std::ranges::sort(priority_list, [&] (workflow::task_id const t_id0, workflow::task_id const t_id1) {
+        double const priority0 = mw.priorities[mw.workflow_of_task[t_id0]];
+        double const priority1 = mw.priorities[mw.workflow_of_task[t_id1]];
+
+        if (priority0 != priority1) {
+            return priority0 > priority1;
+        }
+
+        if (upward_ranks[t_id0] != upward_ranks[t_id1]) {
+            return upward_ranks[t_id0] > upward_ranks[t_id1];
+        }
+
+        return t_id0 < t_id1;
+    });
+
+    std::vector<util::timepoint> task_release_times(mw.w.size());
+    for (workflow::task_id t_id = 0; t_id < mw.w.size(); ++t_id) {
+        task_release_times[t_id] = mw.release_times[mw.workflow_of_task[t_id]];
+    }
+
+    schedule::schedule<M> s(c, options.use_memory_requirements);
+    s.set_release_times(std::move(task_release_times));
+
+    for (workflow::task_id const t_id : priority_list) {
+        s.insert_into_best_eft_node_schedule(t_id, mw.w);
+    }
+
+    return s;
+}
+
+// schedules all workflows of the workflow list jointly and reports the makespan of every workflow
+// (finish of its last task minus its release time) and the utilization of the cluster
+inline void handle_multi_workflow_execution(
+    io::command_line_arguments const & args,
+    cluster::cluster const & c
+) {
+    multi_workflow const mw = read_multi_workflow(io::read_workflow_list_csv(args.workflow_list_input));
+
+    cluster::visit_cost_model(c, [&] <cluster::cost_model M> ([[maybe_unused]] M const & model) {
+        std::clock_t const start = std::clock();
+        schedule::schedule<M> const s = multi_workflow_heft<M>(c, mw, to_algorithm_options(args));
+        std::clock_t const end = std::clock();
+
+        std::vector<util::timepoint> finish_times(mw.num_workflows(), 0.0);
+        util::timepoint busy_time = 0.0;
+
+        s.for_each_interval([&] (
+            workflow::task_id const t_id,
+            schedule::time_interval const & interval,
+            [[maybe_unused]] bool const is_duplicate
+        ) {
+            size_t const k = mw.workflow_of_task[t_id];
+            finish_times[k] = std::max(finish_times[k], interval.end);
+            busy_time += interval.end - interval.start;
+        });
+
+        util::timepoint const makespan = s.get_makespan();
+        double const utilization = makespan == 0.0
+            ? 0.0
+            : busy_time / (makespan * static_cast<double>(c.size()));
+
+        std::stringstream summary{};
+        summary << std::fixed << std::setprecision(2);
+        summary << "Multi workflow -- results:\n";
+
+        for (size_t k = 0; k < mw.num_workflows(); ++k) {
+            util::timepoint const release_time = mw.release_times[k];
+
+            summary << "workflow " << k << " (release time " << release_time
+                << ", priority " << mw.priorities[k] << "): makespan "
+                << finish_times[k] - release_time << ", finished at " << finish_times[k] << '\n';
+        }
+
+        summary << "cluster utilization: " << utilization * 100.0 << " %\n\n";
+
+        io::handle_output_str(args, summary.str());
+
+        if (!args.verbose) {
+            std::cout << summary.str();
+        }
+
+        io::handle_computed_schedule_output(
+            "MULTI_WORKFLOW_HEFT",
+            format_clocks(end - start),
+            args,
+            s,
+            mw.w
+        );
+    });
+}
+
+} // namespace algorithms
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <istream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <algorithms/handle_execution.hpp>
+#include <cluster/cluster.hpp>
+#include <cluster/cost_model.hpp>
+#include <io/command_line_arguments.hpp>
+#include <io/export_schedule.hpp>
+#include <io/handle_output.hpp>
+#include <io/task_bag_stream.hpp>
+#include <schedule/schedule.hpp>
+#include <workflow/task.hpp>
+#include <workflow/task_bag.hpp>
+#include <workflow/task_dependency.hpp>
+#include <workflow/topology/bag_dependency.hpp>
+#include <workflow/topology/infer_dependencies.hpp>
+#include <workflow/topology/topology.hpp>
+#include <workflow/workflow.hpp>
+
+namespace algorithms {
+
+// the bags of the topology that a bag depends on, every source bag must arrive before its target,
+// every bag of the topology has an entry, also if it doesn't depend on any other bag
+using incoming_bag_dependencies = std::unordered_map<
+    workflow::task_bag_id,
+    std::vector<std::pair<workflow::task_bag_id, workflow::topology::bag_dependency>>
+>;
+
+// throws for topologies that can't be scheduled online before any bag is read
+inline incoming_bag_dependencies to_incoming_bag_dependencies(workflow::topology::topology const top) {
+    incoming_bag_dependencies incoming{};
+
+    for (auto const & [source_id, targets] : workflow::topology::to_dependency_pattern(top)) {
+        incoming.try_emplace(source_id);
+
+        for (auto const & [target_id, bag_dep] : targets) {
+            if (source_id >= target_id) {
+                throw std::runtime_error("The online mode requires that every bag only depends on earlier bags.");
+            }
+
+            if (bag_dep == workflow::topology::bag_dependency::complex) {
+                throw std::runtime_error(
+                    "The topology contains a complex bag dependency that can't be inferred, "
+                    "omit the topology and stream all dependencies as dependency lines instead."
+                );
+            }
+
+            incoming[target_id].emplace_back(source_id, bag_dep);
+        }
+    }
+
+    return incoming;
+}
+
+// schedules the bags in the order in which they arrive from the task bag input, each bag is
+// inserted into the existing schedule without changing earlier placements (every task into
+// the node with its best EFT) and its placements are written right away, the dependencies are
+// inferred from the topology (if given) and read from the dependency lines, which have to arrive
+// before the bag of their target task
+// every insertion searches the gaps of all nodes, so the work per bag grows with the number of
+// intervals that the earlier bags left on the nodes
+inline void handle_online_execution(
+    io::command_line_arguments const & args,
+    cluster::cluster const & c
+) {
+    if (!args.dependency_input.empty()) {
+        throw std::runtime_error(
+            "The online mode reads the dependencies from the topology and the dependency lines of the "
+            "task bag input."
+        );
+    }
+
+    std::optional<incoming_bag_dependencies> const incoming = args.topology.empty()
+        ? std::nullopt
+        : std::optional(to_incoming_bag_dependencies(workflow::topology::from_string(args.topology)));
+
+    std::ifstream task_bag_file{};
+    if (args.task_bag_input != "-") {
+        task_bag_file.open(args.task_bag_input);
+
+        if (task_bag_file.fail() || !task_bag_file.is_open()) {
+            throw std::runtime_error("Could not open the task bag file " + args.task_bag_input);
+        }
+    }
+
+    std::istream & task_bag_in = args.task_bag_input == "-" ? std::cin : task_bag_file;
+    io::task_bag_stream bags(task_bag_in);
+
+    // the records are written to the export file or to the command line
+    io::export_format const format = args.export_prefix.empty()
+        ? io::export_format::csv
+        : io::export_format_from_string(args.export_format);
+    if (format == io::export_format::trace) {
+        throw std::runtime_error("The online mode can only export csv or binary records.");
+    }
+
+    std::ofstream export_file{};
+    if (!args.export_prefix.empty()) {
+        export_file = io::open_export_file("ONLINE", args);
+    }
+
+    std::ostream & records_out = args.export_prefix.empty() ? std::cout : export_file;
+
+    // the records of a bag are collected first, so the stream state of the command line
+    // (e.g. its precision) is not changed and every bag is written at once
+    std::stringstream bag_records{};
+    if (format == io::export_format::csv) {
+        io::write_csv_header(bag_records);
+    }
+
+    cluster::visit_cost_model(c, [&] <cluster::cost_model M> ([[maybe_unused]] M const & model) {
+        workflow::workflow w({}, {}, {}, {}, {});
+        schedule::schedule<M> s(c, args.use_memory_requirements);
+
+        std::vector<workflow::task_bag> arrived_bags{};
+        // bag id of every arrived task
+        std::vector<workflow::task_bag_id> task_bag_ids{};
+        // dependency lines whose target task didn't arrive yet
+        std::vector<workflow::task_dependency> pending_dependencies{};
+        std::clock_t total_clocks{0};
+
+        while (auto entry_opt = bags.next()) {
+            if (auto const * const dep = std::get_if<workflow::task_dependency>(&entry_opt.value())) {
+                if (dep->to_id < w.size()) {
+                    throw std::runtime_error(
+                        "A dependency line must arrive before the bag of its target task was placed."
+                    );
+                }
+
+                pending_dependencies.push_back(*dep);
+                continue;
+            }
+
+            std::clock_t const start = std::clock();
+
+            workflow::task_bag const & bag = arrived_bags.emplace_back(
+                std::get<workflow::task_bag>(entry_opt.value())
+            );
+            workflow::task_id const first_t_id = w.size();
+
+            if (incoming && !incoming->contains(bag.id)) {
+                std::stringstream out{};
+                out << "The bag " << bag.id << " is not part of the topology " << args.topology << '.';
+                throw std::runtime_error(out.str());
+            }
+
+            std::vector<workflow::task> tasks{};
+            std::vector<workflow::task_id> bag_task_ids{};
+            for (size_t i = 0; i < bag.cardinality; ++i) {
+                tasks.emplace_back(first_t_id + i, bag.workload, bag.memory_requirement);
+                bag_task_ids.push_back(first_t_id + i);
+                task_bag_ids.push_back(bag.id);
+            }
+
+            auto const check_data_sizes = [&bag] (workflow::task_bag const & source_bag) {
+                if (source_bag.output_data_size != bag.input_data_size) {
+                    std::stringstream out{};
+                    out << "Input/Output data sizes for the dependency between the bags "
+                        << source_bag.id << " and " << bag.id << " don't match.";
+                    throw std::invalid_argument(out.str());
+                }
+            };
+
+            std::vector<workflow::task_dependency> dependencies{};
+
+            if (incoming) {
+                for (auto const & [source_id, bag_dep] : incoming->at(bag.id)) {
+                    check_data_sizes(arrived_bags.at(source_id));
+
+                    workflow::topology::expand_bag_dependency(
+                        bag_dep,
+                        dependencies,
+                        w.get_task_ids_per_bag().at(source_id),
+                        bag_task_ids
+                    );
+                }
+            }
+
+            std::erase_if(pending_dependencies, [&] (workflow::task_dependency const & dep) {
+                if (dep.to_id >= first_t_id + bag.cardinality) {
+                    return false;
+                }
+
+                if (dep.from_id >= first_t_id) {
+                    throw std::runtime_error("A dependency line must lead from a task of an earlier bag.");
+                }
+
+                check_data_sizes(arrived_bags.at(task_bag_ids.at(dep.from_id)));
+                dependencies.push_back(dep);
+                return true;
+            });
+
+            std::vector<double> const data_transfers(dependencies.size(), bag.input_data_size);
+            w.append_task_bag(tasks, dependencies, data_transfers);
+
+            for (workflow::task_id const t_id : bag_task_ids) {
+                s.insert_into_best_eft_node_schedule(t_id, w);
+            }
+
+            for (workflow::task_id const t_id : bag_task_ids) {
+                auto const & interval = s.get_task_intervals(t_id).front();
+                io::write_schedule_record(bag_records, format, t_id, interval, false);
+            }
+
+            // not the stream buffer, streaming an empty one (a bag without tasks) sets the failbit
+            records_out << bag_records.str();
+            records_out.flush();
+            bag_records.str({});
+            bag_records.clear();
+
+            std::clock_t const end = std::clock();
+            total_clocks += end - start;
+
+            std::stringstream out{};
+            out << "ONLINE -- bag " << bag.id << " with " << bag.cardinality << " tasks placed in "
+                << format_clocks(end - start) << '\n';
+            io::handle_output_str(args, out.str());
+        }
+
+        if (!pending_dependencies.empty()) {
+            throw std::runtime_error("A dependency line targets a task that never arrived.");
+        }
+
+        // the records were already exported while the bags arrived
+        io::command_line_arguments summary_args = args;
+        summary_args.export_prefix.clear();
+
+        io::handle_computed_schedule_output(
+            "ONLINE",
+            format_clocks(total_clocks),
+            summary_args,
+            s,
+            w
+        );
+    });
+}
+
+} // namespace algorithms
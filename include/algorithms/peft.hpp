@@ -0,0 +1,205 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <stop_token>
+#include <vector>
+
+#include <algorithms/algorithm_options.hpp>
+#include <cluster/cluster.hpp>
+#include <cluster/cost_model.hpp>
+#include <schedule/schedule.hpp>
+#include <util/parallel_for.hpp>
+#include <util/timepoint.hpp>
+#include <util/trace.hpp>
+#include <workflow/workflow.hpp>
+
+namespace algorithms {
+
+// optimistic cost table, OCT(t, p) is the shortest time from the start of task t on node p
+// until all exit tasks are finished, assuming that every successor is placed on its best node
+// stored as a flat row-major (#tasks x #nodes) matrix
+class optimistic_cost_table {
+    size_t num_nodes;
+    std::vector<double> table;
+
+public:
+    template <cluster::cost_model M>
+    optimistic_cost_table(
+        cluster::cluster const & c,
+        workflow::workflow const & w,
+        M const & model
+    ) : num_nodes(c.size()), table(w.size() * c.size(), 0.0) {
+        // the mean bandwidth is used for communication costs as for the upward ranks of HEFT
+        double const inverse_mean_bandwidth = 1.0 / c.mean_bandwidth();
+
+        // min over all nodes p of OCT(s, p) + w(s, p) for the computation time w, cached as soon
+        // as the OCT row of a task is complete, the sums themselves are recomputed when needed
+        // such that the table is the only (#tasks x #nodes) matrix
+        std::vector<double> min_successor_costs(w.size());
+
+        // every thread should compute at least this many table entries per level
+        size_t constexpr min_entries_per_thread = 1ul << 16;
+        size_t const min_tasks_per_thread = std::max(min_entries_per_thread / num_nodes, 1ul);
+
+        size_t const num_levels = w.num_topological_levels();
+
+        // all successors of a task are in higher levels, so the tasks of a level are independent
+        for (size_t i = 0; i < num_levels; ++i) {
+            auto const level_task_ids = w.get_topological_level(num_levels - 1 - i);
+
+            util::parallel_for(level_task_ids.size(), min_tasks_per_thread, [&] (size_t const j) {
+                workflow::task_id const t_id = level_task_ids[j];
+                double * const oct_row = row_pointer(t_id);
+
+                for (auto const & [succ_id, data_transfer] : w.get_task_outgoing_edges(t_id)) {
+                    double const * const succ_row = table.data() + succ_id * num_nodes;
+                    double const succ_workload = w.get_task(succ_id).workload;
+                    // on a different node than p, the successor can use its best node
+                    double const remote_cost = min_successor_costs[succ_id]
+                        + data_transfer * inverse_mean_bandwidth;
+
+                    // branch free max/min over contiguous rows, vectorized by the compiler
+                    for (cluster::node_id p = 0; p < num_nodes; ++p) {
+                        double const succ_cost = succ_row[p] + model.computation_time(succ_workload, p);
+                        oct_row[p] = std::max(oct_row[p], std::min(succ_cost, remote_cost));
+                    }
+                }
+
+                min_successor_costs[t_id] = min_cost_of_row(oct_row, model, w.get_task(t_id).workload);
+            });
+        }
+    }
+
+    double operator() (workflow::task_id const t_id, cluster::node_id const n_id) const {
+        return table[t_id * num_nodes + n_id];
+    }
+
+    // rank_oct in the paper, the mean OCT of a task over all nodes
+    double mean(workflow::task_id const t_id) const {
+        double const * const row = table.data() + t_id * num_nodes;
+        double sum = 0.0;
+
+        for (cluster::node_id p = 0; p < num_nodes; ++p) {
+            sum += row[p];
+        }
+
+        return sum / static_cast<double>(num_nodes);
+    }
+
+private:
+    double * row_pointer(workflow::task_id const t_id) {
+        return table.data() + t_id * num_nodes;
+    }
+
+    // min over all nodes p of row[p] + w(p) for the computation time w of the workload,
+    // four independent accumulators break the dependency chain of the reduction
+    template <cluster::cost_model M>
+    double min_cost_of_row(double const * const row, M const & model, double const workload) const {
+        double constexpr inf = std::numeric_limits<double>::infinity();
+        double min0{inf}, min1{inf}, min2{inf}, min3{inf};
+
+        cluster::node_id p = 0;
+        for (; p + 4 <= num_nodes; p += 4) {
+            min0 = std::min(min0, row[p] + model.computation_time(workload, p));
+            min1 = std::min(min1, row[p + 1] + model.computation_time(workload, p + 1));
+            min2 = std::min(min2, row[p + 2] + model.computation_time(workload, p + 2));
+            min3 = std::min(min3, row[p + 3] + model.computation_time(workload, p + 3));
+        }
+
+        for (; p < num_nodes; ++p) {
+            min0 = std::min(min0, row[p] + model.computation_time(workload, p));
+        }
+
+        return std::min(std::min(min0, min1), std::min(min2, min3));
+    }
+};
+
+// Predict earliest finish time
+
+// Running time analysis:
+// input: cluster C, workflow-DAG W = (V,E)
+// O(|E| * |C|) for the optimistic cost table, the list scheduling is the same as for HEFT
+
+// tie-breaking for the ready list: lower id task -> higher priority
+
+template <cluster::cost_model M>
+void peft(
+    cluster::cluster const & c,
+    workflow::workflow const & w,
+    algorithm_options const & options,
+    schedule::schedule<M> & s,
+    std::stop_token const stop_token = {}
+) {
+    TRACE_ALGORITHM("PEFT");
+    TRACE_PHASE("optimistic cost table");
+
+    M const model(c);
+    optimistic_cost_table const oct(c, w, model);
+
+    std::vector<double> task_priorities(w.size());
+    for (workflow::task_id t_id = 0; t_id < w.size(); ++t_id) {
+        task_priorities[t_id] = oct.mean(t_id);
+    }
+
+    TRACE_PHASE("insertion");
+    s.reset(options.use_memory_requirements);
+
+    struct prioritized_task {
+        workflow::task_id id;
+        double priority;
+    };
+
+    struct task_priority_compare {
+        bool operator() (prioritized_task const & t0, prioritized_task const & t1) const {
+            // this should be analogous to the std::less operator regarding priority (t0 < t1?)
+            if (t0.priority == t1.priority) {
+                return t0.id > t1.id;
+            }
+
+            return t0.priority < t1.priority;
+        }
+    };
+
+    std::priority_queue<prioritized_task, std::vector<prioritized_task>, task_priority_compare> ready_list;
+
+    for (workflow::task_id const & t_id : w.get_independent_task_ids()) {
+        ready_list.push({ t_id, task_priorities[t_id] });
+    }
+
+    // count the unscheduled predecessors of each task to identify new ready tasks
+    auto remaining_in_degrees = w.get_task_in_degrees();
+
+    while (!ready_list.empty()) {
+        if (stop_token.stop_requested()) {
+            break;
+        }
+
+        workflow::task_id const curr_t_id = ready_list.top().id;
+        ready_list.pop();
+
+        TRACE_TASK_SPAN("insert task", curr_t_id);
+
+        // the optimistic EFT also accounts for the path from the task to the exit tasks
+        s.insert_into_best_node_schedule(curr_t_id, w,
+            [&oct, curr_t_id] (cluster::node_id const n_id, util::timepoint const eft) {
+                return eft + oct(curr_t_id, n_id);
+            }
+        );
+
+        for (auto const & [neighbor_id, weight] : w.get_task_outgoing_edges(curr_t_id)) {
+            size_t & neighbor_in_degree = remaining_in_degrees.at(neighbor_id);
+            if (neighbor_in_degree == 0) {
+                throw std::runtime_error("Internal bug: incoming/outgoing edges are out of sync");
+            }
+
+            if (--neighbor_in_degree == 0) {
+                ready_list.push({ neighbor_id, task_priorities[neighbor_id] });
+            }
+        }
+    }
+}
+
+} // namespace algorithms
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <ctime>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <algorithms/algorithm.hpp>
+#include <algorithms/algorithm_options.hpp>
+#include <algorithms/handle_execution.hpp>
+#include <cluster/cluster.hpp>
+#include <cluster/cost_model.hpp>
+#include <io/command_line_arguments.hpp>
+#include <io/handle_output.hpp>
+#include <schedule/schedule.hpp>
+#include <workflow/workflow.hpp>
+
+namespace algorithms {
+
+// runs all algorithms in parallel and only emits the schedule with the lowest makespan,
+// algorithms that are still running when the time budget is used up are stopped cooperatively
+// and only complete schedules are considered
+inline void handle_portfolio_execution(
+    io::command_line_arguments const & args,
+    cluster::cluster const & c,
+    workflow::workflow const & w
+) {
+    cluster::visit_cost_model(c, [&] <cluster::cost_model M> ([[maybe_unused]] M const & model) {
+        std::clock_t const start = std::clock();
+
+        // the algorithms themselves must not write any output
+        algorithm_options algo_options = to_algorithm_options(args);
+        algo_options.verbose = false;
+        algo_options.output.clear();
+
+        std::vector<std::optional<schedule::schedule<M>>> results(ALL.size());
+        std::vector<std::exception_ptr> exceptions(ALL.size());
+
+        std::stop_source stop_source{};
+        std::mutex mutex{};
+        std::condition_variable finished_cv{};
+        size_t num_finished{0};
+
+        {
+            // jthreads join on destruction after the stop was requested
+            std::vector<std::jthread> workers{};
+            workers.reserve(ALL.size());
+
+            for (size_t i = 0; i < ALL.size(); ++i) {
+                workers.emplace_back([&, i] () {
+                    try {
+                        auto const func = to_function<M>(ALL[i], c, w, algo_options, stop_source.get_token());
+                        results[i].emplace(func());
+                    } catch (...) {
+                        exceptions[i] = std::current_exception();
+                    }
+
+                    {
+                        std::lock_guard<std::mutex> const lock(mutex);
+                        ++num_finished;
+                    }
+                    finished_cv.notify_one();
+                });
+            }
+
+            std::unique_lock<std::mutex> lock(mutex);
+            auto const all_finished = [&num_finished] () {
+                return num_finished == ALL.size();
+            };
+
+            if (args.time_budget_ms == 0) {
+                finished_cv.wait(lock, all_finished);
+            } else {
+                finished_cv.wait_for(lock, std::chrono::milliseconds(args.time_budget_ms), all_finished);
+            }
+
+            lock.unlock();
+            stop_source.request_stop();
+        }
+
+        for (std::exception_ptr const & exception : exceptions) {
+            if (exception) {
+                std::rethrow_exception(exception);
+            }
+        }
+
+        std::clock_t const end = std::clock();
+
+        std::optional<size_t> best_index{};
+        std::stringstream summary{};
+        summary << "Portfolio -- results:\n";
+
+        for (size_t i = 0; i < ALL.size(); ++i) {
+            summary << to_string(ALL[i]) << ": ";
+
+            if (!results[i]->is_complete(w)) {
+                summary << "stopped\n";
+                continue;
+            }
+
+            summary << "makespan " << results[i]->get_makespan() << '\n';
+
+            if (!best_index || results[i]->get_makespan() < results[best_index.value()]->get_makespan()) {
+                best_index = i;
+            }
+        }
+
+        if (!best_index) {
+            throw std::runtime_error("No algorithm of the portfolio finished within the time budget.");
+        }
+
+        std::string const algo_str = to_string(ALL[best_index.value()]);
+        summary << "best schedule computed by " << algo_str << "\n\n";
+
+        io::handle_output_str(args, summary.str());
+
+        if (!args.verbose) {
+            std::cout << "Portfolio -- best schedule computed by " << algo_str << '\n';
+        }
+
+        io::handle_computed_schedule_output(
+            algo_str,
+            format_clocks(end - start) + " (whole portfolio)",
+            args,
+            results[best_index.value()].value(),
+            w
+        );
+    });
+}
+
+} // namespace algorithms
@@ -1,13 +1,16 @@
 #pragma once
 
 #include <algorithm>
+#include <stop_token>
 #include <vector>
 
+#include <algorithms/algorithm_options.hpp>
 #include <algorithms/common_clustering_based.hpp>
 #include <cluster/cluster.hpp>
-#include <io/command_line_arguments.hpp>
+#include <cluster/cost_model.hpp>
 #include <io/issue_warning.hpp>
 #include <schedule/schedule.hpp>
+#include <util/trace.hpp>
 #include <workflow/task.hpp>
 #include <workflow/workflow.hpp>
 
@@ -15,7 +18,7 @@ namespace algorithms {
 
 // in our model all tasks in a level/bag have the same workload
 // hence, we only have to distribute the tasks evenly
-std::vector<task_group> runtime_balanced_task_groups(
+inline std::vector<task_group> runtime_balanced_task_groups(
     workflow::workflow const & w,
     std::vector<workflow::task_id> const & bag, 
     size_t const num_cluster_nodes
@@ -47,15 +50,20 @@ std::vector<task_group> runtime_balanced_task_groups(
 // Running time analysis:
 // TODO
 
-schedule::schedule rbca(
+template <cluster::cost_model M>
+void rbca(
     cluster::cluster const & c, 
     workflow::workflow const & w,
-    io::command_line_arguments const & args
+    algorithm_options const & options,
+    schedule::schedule<M> & s,
+    std::stop_token const stop_token = {}
 ) {
-    schedule::schedule s(c, args.use_memory_requirements);
+    TRACE_ALGORITHM("RBCA");
 
-    if (args.use_memory_requirements) {
-        io::issue_warning(args, "Memory requirements not implemented/used for RBCA");
+    s.reset(options.use_memory_requirements);
+
+    if (options.use_memory_requirements) {
+        io::issue_warning(options.verbose, options.output, "Memory requirements not implemented/used for RBCA");
     }
 
     // we use our bags instead of the levels as defined in the original paper 
@@ -63,13 +71,16 @@ schedule::schedule rbca(
     auto const & task_ids_per_bag = w.get_task_ids_per_bag();
 
     for (auto const & bag: task_ids_per_bag) {
+        if (stop_token.stop_requested()) {
+            break;
+        }
+
+        TRACE_SPAN("bag", "schedule bag");
         auto groups = runtime_balanced_task_groups(w, bag, c.size());
         select_good_processors_for_expensive_groups(
-            c, w, s, groups, args.use_memory_requirements
+            c, w, s, groups, options.use_memory_requirements
         );
     }
-
-    return s;
 }
 
 } // namespace algorithms
@@ -2,35 +2,31 @@
 
 #include <numeric>
 #include <optional>
+#include <stop_token>
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include <algorithms/algorithm_options.hpp>
 #include <algorithms/common_clustering_based.hpp>
 #include <cluster/cluster.hpp>
-#include <io/command_line_arguments.hpp>
+#include <cluster/cost_model.hpp>
 #include <io/issue_warning.hpp>
 #include <schedule/schedule.hpp>
+#include <util/sort_by_key.hpp>
 #include <util/timepoint.hpp>
-#include <workflow/data_transfer_cost.hpp>
+#include <util/trace.hpp>
 #include <workflow/node_task_matrix.hpp>
 #include <workflow/workflow.hpp>
 
 namespace algorithms {
 
-std::vector<workflow::task_id> task_ids_sorted_by_level_ascending(
-    workflow::workflow const & w,
-    std::unordered_map<workflow::task_id, double> const & level
+// ties are broken by the lower id
+inline std::vector<workflow::task_id> task_ids_sorted_by_level_ascending(
+    std::vector<double> const & level
 ) {
-    auto task_ids = std::ranges::iota_view{0ul, w.size()};
-    std::vector<workflow::task_id> level_task_ids(task_ids.begin(), task_ids.end());
-
-    std::ranges::sort(level_task_ids, {}, [&level] (auto const & t_id) {
-        return level.at(t_id);
-    });
-
-    return level_task_ids;
+    return util::ids_sorted_by_key(level, false);
 }
 
 // pop and returns last element of the vector
@@ -42,8 +38,10 @@ T pop_back_and_return(std::vector<T> & v) {
     return item;
 }
 
+template <cluster::cost_model M>
 std::optional<workflow::task_id> find_better_predecessor(// the predecessor is k in the paper
     cluster::cluster const & c,
+    M const & model,
     workflow::workflow const & w,
     node_task_matrix<util::timepoint> const & eft,
     std::unordered_set<workflow::task_id> const & assigned_task_ids,
@@ -56,9 +54,10 @@ std::optional<workflow::task_id> find_better_predecessor(// the predecessor is k
         | std::views::filter([&] (auto const & edge) {
             auto const & [neighbor_id, data_transfer] = edge;
 
-            auto const data_transfer_cost = workflow::get_raw_data_transfer_cost(
+            auto const data_transfer_cost = model.raw_data_transfer_cost(
                 data_transfer, 
-                c.uniform_bandwidth()
+                best_node_id,
+                curr_node_id
             );
 
             return !assigned_task_ids.contains(neighbor_id)
@@ -77,15 +76,15 @@ std::optional<workflow::task_id> find_better_predecessor(// the predecessor is k
     return std::nullopt;
 }
 
-schedule::schedule schedule_from_groups(
+// inserts the tasks of the groups into the empty schedule s
+template <cluster::cost_model M>
+void insert_groups_into_schedule(
     cluster::cluster const & c,
     workflow::workflow const & w,
     std::vector<task_group> const & groups,
-    bool const unscheduled_predecessors_allowed = false,
-    bool const use_memory_requirements = false
+    schedule::schedule<M> & s,
+    bool const unscheduled_predecessors_allowed = false
 ) {
-    schedule::schedule s(c, use_memory_requirements);
-
     std::unordered_map<workflow::task_id, std::vector<cluster::node_id>> task_to_nodes;
 
     for (auto const & t : w) {
@@ -104,14 +103,27 @@ schedule::schedule schedule_from_groups(
             s.insert_into_node_schedule(t_id, n_id, w, unscheduled_predecessors_allowed);
         }
     }
+}
+
+template <cluster::cost_model M>
+schedule::schedule<M> schedule_from_groups(
+    cluster::cluster const & c,
+    workflow::workflow const & w,
+    std::vector<task_group> const & groups,
+    bool const unscheduled_predecessors_allowed = false,
+    bool const use_memory_requirements = false
+) {
+    schedule::schedule<M> s(c, use_memory_requirements);
+    insert_groups_into_schedule<M>(c, w, groups, s, unscheduled_predecessors_allowed);
 
     return s;
 }
 
+template <cluster::cost_model M>
 std::vector<task_group> groups_from_schedule(
     cluster::cluster const & c,
     workflow::workflow const & w,
-    schedule::schedule const & s
+    schedule::schedule<M> const & s
 ) {
     std::vector<task_group> groups(c.size());
 
@@ -127,17 +139,19 @@ std::vector<task_group> groups_from_schedule(
 }
 
 // in the paper: Initial task clustering
+template <cluster::cost_model M>
 std::vector<task_group> initial_groups(
     cluster::cluster const & c,
+    M const & model,
     workflow::workflow const & w,
-    std::unordered_map<workflow::task_id, double> const & level,
+    std::vector<double> const & level,
     std::vector<workflow::task_id> const & cpred,
     node_task_matrix<util::timepoint> const & eft
 ) {
     std::vector<task_group> groups(c.size());
 
     // lowest "level" score to the back
-    auto const sorted_task_ids = task_ids_sorted_by_level_ascending(w, level);
+    auto const sorted_task_ids = task_ids_sorted_by_level_ascending(level);
     // best node ids to the back
     auto remaining_node_ids = c.node_ids_sorted_by_performance_ascending();
 
@@ -167,9 +181,10 @@ std::vector<task_group> initial_groups(
             auto next_task_id = cpred.at(curr_task_id); // j in the paper
             
             auto const & curr_task_incoming_edges = w.get_task_incoming_edges(curr_task_id);
-            auto const data_transfer_cost = workflow::get_raw_data_transfer_cost(
+            auto const data_transfer_cost = model.raw_data_transfer_cost(
                 curr_task_incoming_edges.at(next_task_id), 
-                c.uniform_bandwidth()
+                best_node_id,
+                curr_node_id
             );
 
             if (
@@ -184,6 +199,7 @@ std::vector<task_group> initial_groups(
             ) {
                 auto const better_task_opt = find_better_predecessor(
                     c,
+                    model,
                     w, 
                     eft,
                     assigned_task_ids,
@@ -206,7 +222,7 @@ std::vector<task_group> initial_groups(
         }
     }
 
-    auto s = schedule_from_groups(c, w, groups, true);
+    auto s = schedule_from_groups<M>(c, w, groups, true);
     if (assigned_task_ids.size() < w.size()) {
         // add remaing tasks to the respective groups that minimize their est
         for (workflow::task_id const curr_task_id : w.get_task_topological_order()) {
@@ -225,11 +241,13 @@ std::vector<task_group> initial_groups(
     return groups;
 }
 
+template <cluster::cost_model M>
 void task_duplication(
     cluster::cluster const & c,
     workflow::workflow const & w,
     std::vector<task_group> & groups,
     std::vector<workflow::task_id> const & cpred,
+    std::stop_token const stop_token,
     size_t const num_iterations = 4,
     [[maybe_unused]] bool const use_memory_requirements = false
 ) {
@@ -246,14 +264,23 @@ void task_duplication(
         unoccupied_nodes_view.end()
     );
 
-    schedule::schedule curr_sched = schedule_from_groups(c, w, groups);
+    schedule::schedule<M> curr_sched = schedule_from_groups<M>(c, w, groups);
 
     for ([[maybe_unused]] auto const iter_num : iota_view{0ul, num_iterations}) {
         for (cluster::node_id const curr_node_id : iota_view{0ul, c.size()}) {
+            if (stop_token.stop_requested()) {
+                return;
+            }
+
             auto task_ids = groups.at(curr_node_id).get_tasks_in_topologcal_order(w);
 
             if (task_ids.size() > 1) {
                 for (size_t const i : iota_view{1ul, task_ids.size()} | std::views::reverse) {
+                    // every candidate needs a full schedule evaluation, so check before each one
+                    if (stop_token.stop_requested()) {
+                        return;
+                    }
+
                     cluster::node_id const next_node_id = unoccupied_nodes.empty()
                         ? c.best_performance_node()
                         : pop_back_and_return(unoccupied_nodes);
@@ -277,7 +304,7 @@ void task_duplication(
                         }
 
                         // check whether these moves improved the makespan
-                        schedule::schedule const temp_sched = schedule_from_groups(c, w, temp_groups);
+                        schedule::schedule<M> const temp_sched = schedule_from_groups<M>(c, w, temp_groups);
 
                         if (temp_sched.get_makespan() <= curr_sched.get_makespan()) {
                             curr_sched = std::move(temp_sched);
@@ -305,7 +332,7 @@ void task_duplication(
                 }
 
                 // check whether these additions improved the makespan
-                schedule::schedule const temp_sched = schedule_from_groups(c, w, temp_groups);
+                schedule::schedule<M> const temp_sched = schedule_from_groups<M>(c, w, temp_groups);
 
                 if (temp_sched.get_makespan() <= curr_sched.get_makespan()) {
                     curr_sched = std::move(temp_sched);
@@ -316,21 +343,27 @@ void task_duplication(
     }
 }
 
+template <cluster::cost_model M>
 void merge_nodes(
     cluster::cluster const & c,
     workflow::workflow const & w,
     std::vector<task_group> & groups,
+    std::stop_token const stop_token,
     size_t const num_iterations = 4,
     [[maybe_unused]] bool const use_memory_requirements = false
 ) {
     using std::ranges::iota_view;
 
-    schedule::schedule curr_sched = schedule_from_groups(c, w, groups);
+    schedule::schedule<M> curr_sched = schedule_from_groups<M>(c, w, groups);
 
     cluster::node_id const best_node_id = c.best_performance_node();
 
     for ([[maybe_unused]] auto const iter_num : iota_view{0ul, num_iterations}) {
         for (cluster::node_id const curr_node_id : iota_view{0ul, c.size()}) {
+            if (stop_token.stop_requested()) {
+                return;
+            }
+
             std::vector<task_group> temp_groups = groups;
 
             // move all the tasks before the i-th to the best node
@@ -342,7 +375,7 @@ void merge_nodes(
             }
 
             // check whether these moves improved the makespan
-            schedule::schedule const temp_sched = schedule_from_groups(c, w, temp_groups);
+            schedule::schedule<M> const temp_sched = schedule_from_groups<M>(c, w, temp_groups);
 
             if (temp_sched.get_makespan() <= curr_sched.get_makespan()) {
                 curr_sched = std::move(temp_sched);
@@ -352,16 +385,22 @@ void merge_nodes(
     }
 }
 
+template <cluster::cost_model M>
 void refine_edges(
     cluster::cluster const & c,
     workflow::workflow const & w,
     std::vector<task_group> & groups,
+    std::stop_token const stop_token,
     [[maybe_unused]] bool const use_memory_requirements = false
 ) {
-    schedule::schedule curr_sched = schedule_from_groups(c, w, groups);
+    schedule::schedule<M> curr_sched = schedule_from_groups<M>(c, w, groups);
     auto const differing_edges = curr_sched.get_different_node_edges(w);
 
     for (auto const & edge : differing_edges) {
+        if (stop_token.stop_requested()) {
+            return;
+        }
+
         std::vector<task_group> temp_groups = groups;
 
         // add the "from" task to the "to" node
@@ -385,7 +424,7 @@ void refine_edges(
         }
 
         // check whether this move improved the makespan
-        schedule::schedule const temp_sched = schedule_from_groups(c, w, temp_groups);
+        schedule::schedule<M> const temp_sched = schedule_from_groups<M>(c, w, temp_groups);
 
         if (temp_sched.get_makespan() <= curr_sched.get_makespan()) {
             curr_sched = std::move(temp_sched);
@@ -394,36 +433,52 @@ void refine_edges(
     }
 }
 
-schedule::schedule tdca(
+template <cluster::cost_model M>
+void tdca(
     cluster::cluster const & c, 
     workflow::workflow const & w,
-    io::command_line_arguments const & args
+    algorithm_options const & options,
+    schedule::schedule<M> & s,
+    std::stop_token const stop_token = {}
 ) {
-    if (args.use_memory_requirements) {
-        io::issue_warning(args, "Memory requirements not implemented/used for RBCA");
+    TRACE_ALGORITHM("TDCA");
+
+    if (options.use_memory_requirements) {
+        io::issue_warning(options.verbose, options.output, "Memory requirements not implemented/used for RBCA");
     }
 
-    auto const [est, eft, cpred] = w.compute_est_and_eft(c); // eft == ect in the paper
+    TRACE_PHASE("earliest start and finish times");
+
+    M const model(c);
+    auto const [est, eft, cpred] = w.compute_est_and_eft(c, model); // eft == ect in the paper
 
     // in our model, the favorite nodes of all tasks are simply 
     // the ones with the best performance
     auto const favorite_nodes = c.node_ids_sorted_by_performance_descending();
 
     // borrow code from the HEFT implementation, hence the name upward ranks
-    auto const level = w.all_upward_ranks(
+    TRACE_PHASE("levels");
+    auto const & level = w.all_upward_ranks(
         c.worst_performance_node(),
-        c.uniform_bandwidth()
+        c.mean_bandwidth()
     );
 
-    auto groups = initial_groups(c, w, level, cpred, eft);
+    TRACE_PHASE("initial groups");
+    auto groups = initial_groups(c, model, w, level, cpred, eft);
 
-    task_duplication(c, w, groups, cpred);
+    // the improvement phases stop early on request, the groups always stay complete
+    TRACE_PHASE("task duplication");
+    task_duplication<M>(c, w, groups, cpred, stop_token);
 
-    merge_nodes(c, w, groups);
+    TRACE_PHASE("merge nodes");
+    merge_nodes<M>(c, w, groups, stop_token);
 
-    refine_edges(c, w, groups);
+    TRACE_PHASE("refine edges");
+    refine_edges<M>(c, w, groups, stop_token);
 
-    return schedule_from_groups(c, w, groups);
+    TRACE_PHASE("schedule from groups");
+    s.reset(false);
+    insert_groups_into_schedule<M>(c, w, groups, s);
 }
 
 } // namespace algorithms
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cluster/cluster_node.hpp>
+
+namespace cluster {
+
+// a rack contains the nodes first_node_id, ..., last_node_id
+struct rack {
+    node_id first_node_id;
+    node_id last_node_id;
+    double intra_rack_bandwidth;
+    double inter_rack_bandwidth;
+};
+
+struct link {
+    node_id from_id;
+    node_id to_id;
+    double bandwidth;
+};
+
+// bandwidths of all links between two nodes, stored blockwise:
+// every node belongs to a group and all links between two groups have the same bandwidth,
+// so racks need a (#racks x #racks) matrix and arbitrary links a dense (#nodes x #nodes) one
+class bandwidth_matrix {
+    size_t num_groups;
+    std::vector<size_t> group_of_node;
+    // row-major num_groups x num_groups
+    std::vector<double> group_bandwidths;
+
+public:
+    bandwidth_matrix(
+        size_t const num_groups_,
+        std::vector<size_t> group_of_node_,
+        std::vector<double> group_bandwidths_
+    ) : num_groups(num_groups_),
+        group_of_node(std::move(group_of_node_)),
+        group_bandwidths(std::move(group_bandwidths_)) {
+        if (group_bandwidths.size() != num_groups * num_groups) {
+            throw std::runtime_error("Internal bug: bandwidth matrix has the wrong size.");
+        }
+
+        if (std::ranges::any_of(group_bandwidths, [] (double const bw) { return bw <= 0.0; })) {
+            throw std::invalid_argument("All link bandwidths must be positive.");
+        }
+    }
+
+    // the links between two different racks have the smaller inter rack bandwidth of both racks
+    static bandwidth_matrix from_racks(size_t const num_nodes, std::vector<rack> const & racks) {
+        size_t const num_racks = racks.size();
+        std::vector<size_t> group_of_node(num_nodes, num_racks);
+        std::vector<double> group_bandwidths(num_racks * num_racks);
+
+        for (size_t r = 0; r < num_racks; ++r) {
+            rack const & curr = racks[r];
+
+            if (curr.first_node_id > curr.last_node_id || curr.last_node_id >= num_nodes) {
+                throw std::invalid_argument("A rack contains invalid node ids.");
+            }
+
+            for (node_id n_id = curr.first_node_id; n_id <= curr.last_node_id; ++n_id) {
+                if (group_of_node[n_id] != num_racks) {
+                    throw std::invalid_argument("A node is part of multiple racks.");
+                }
+
+                group_of_node[n_id] = r;
+            }
+
+            for (size_t other = 0; other < num_racks; ++other) {
+                group_bandwidths[r * num_racks + other] = r == other
+                    ? curr.intra_rack_bandwidth
+                    : std::min(curr.inter_rack_bandwidth, racks[other].inter_rack_bandwidth);
+            }
+        }
+
+        if (std::ranges::find(group_of_node, num_racks) != group_of_node.end()) {
+            throw std::invalid_argument("Every cluster node must be part of exactly one rack.");
+        }
+
+        return bandwidth_matrix(num_racks, std::move(group_of_node), std::move(group_bandwidths));
+    }
+
+    // links are symmetric, links that are not given have the smaller network bandwidth of both nodes
+    static bandwidth_matrix from_links(
+        std::vector<cluster_node> const & nodes,
+        std::vector<link> const & links
+    ) {
+        size_t const num_nodes = nodes.size();
+        std::vector<size_t> group_of_node(num_nodes);
+        std::vector<double> group_bandwidths(num_nodes * num_nodes);
+
+        for (node_id from_id = 0; from_id < num_nodes; ++from_id) {
+            group_of_node[from_id] = from_id;
+
+            for (node_id to_id = 0; to_id < num_nodes; ++to_id) {
+                group_bandwidths[from_id * num_nodes + to_id] = std::min(
+                    nodes[from_id].network_bandwidth,
+                    nodes[to_id].network_bandwidth
+                );
+            }
+        }
+
+        for (link const & l : links) {
+            if (l.from_id >= num_nodes || l.to_id >= num_nodes) {
+                throw std::invalid_argument("A link contains an invalid node id.");
+            }
+
+            group_bandwidths[l.from_id * num_nodes + l.to_id] = l.bandwidth;
+            group_bandwidths[l.to_id * num_nodes + l.from_id] = l.bandwidth;
+        }
+
+        return bandwidth_matrix(num_nodes, std::move(group_of_node), std::move(group_bandwidths));
+    }
+
+    double bandwidth(node_id const from_id, node_id const to_id) const {
+        return group_bandwidths[group_of_node[from_id] * num_groups + group_of_node[to_id]];
+    }
+
+    size_t get_num_groups() const {
+        return num_groups;
+    }
+
+    size_t group(node_id const n_id) const {
+        return group_of_node[n_id];
+    }
+
+    double group_bandwidth(size_t const from_group, size_t const to_group) const {
+        return group_bandwidths[from_group * num_groups + to_group];
+    }
+
+    // mean over all links between two different nodes
+    double mean_bandwidth() const {
+        size_t const num_nodes = group_of_node.size();
+
+        if (num_nodes < 2) {
+            return group_bandwidths.front();
+        }
+
+        // count the nodes per group such that the sum needs O(#groups^2) instead of O(#nodes^2)
+        std::vector<double> group_sizes(num_groups, 0.0);
+        for (size_t const g : group_of_node) {
+            group_sizes[g] += 1.0;
+        }
+
+        double bandwidth_sum = 0.0;
+        for (size_t from_group = 0; from_group < num_groups; ++from_group) {
+            for (size_t to_group = 0; to_group < num_groups; ++to_group) {
+                double const num_links = from_group == to_group
+                    ? group_sizes[from_group] * (group_sizes[from_group] - 1.0)
+                    : group_sizes[from_group] * group_sizes[to_group];
+
+                bandwidth_sum += num_links * group_bandwidth(from_group, to_group);
+            }
+        }
+
+        double const num_nodes_d = static_cast<double>(num_nodes);
+        return bandwidth_sum / (num_nodes_d * (num_nodes_d - 1.0));
+    }
+
+    std::string to_string() const {
+        std::stringstream out;
+
+        out << "Link bandwidths between " << num_groups << " node groups:\n";
+        for (size_t from_group = 0; from_group < num_groups; ++from_group) {
+            out << "Group " << from_group << ':';
+            for (size_t to_group = 0; to_group < num_groups; ++to_group) {
+                out << ' ' << group_bandwidth(from_group, to_group);
+            }
+            out << '\n';
+        }
+
+        return out.str();
+    }
+};
+
+} // namespace cluster
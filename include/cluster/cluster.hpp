@@ -4,12 +4,15 @@
 #include <iostream>
 #include <functional>
 #include <numeric>
+#include <optional>
 #include <ranges>
 #include <sstream>
 #include <stdexcept>
 #include <vector>
 
+#include <cluster/bandwidth_matrix.hpp>
 #include <cluster/cluster_node.hpp>
+#include <cluster/core_model.hpp>
 
 namespace cluster {
 
@@ -19,12 +22,25 @@ public:
 
 private:
     std::vector<cluster_node> const nodes{};
+    // if not given, data is sent with the network bandwidth of the sending node
+    std::optional<bandwidth_matrix> const link_bandwidths{};
+    // if not given, every task uses the whole node and the tasks of a node run one after another
+    std::optional<core_model> const cores{};
 
 public:
-    cluster(std::vector<cluster_node> const nodes_) 
-    : nodes(std::move(nodes_)) 
+    cluster(
+        std::vector<cluster_node> const nodes_,
+        std::optional<bandwidth_matrix> link_bandwidths_ = std::nullopt,
+        std::optional<core_model> const cores_ = std::nullopt
+    ) 
+    : nodes(std::move(nodes_)), link_bandwidths(std::move(link_bandwidths_)), cores(cores_)
     {}
 
+    // in the core model, the performance of a task that uses the maximum number of cores
+    double performance(cluster_node const & node) const {
+        return cores ? cores->performance(node) : node.performance();
+    }
+
     std::vector<node_id> node_ids() const {
         std::vector<node_id> ids(nodes.size());
         std::iota(ids.begin(), ids.end(), 0);
@@ -35,7 +51,7 @@ public:
     std::vector<node_id> node_ids_sorted_by_performance_descending() const {
         auto ids = node_ids();
         std::ranges::sort(ids, std::ranges::greater(), [this] (node_id const & n_id) {
-            return nodes.at(n_id).performance();
+            return performance(nodes.at(n_id));
         });
 
         return ids;
@@ -44,7 +60,7 @@ public:
     std::vector<node_id> node_ids_sorted_by_performance_ascending() const {
         auto ids = node_ids();
         std::ranges::sort(ids, {}, [this] (node_id const & n_id) {
-            return nodes.at(n_id).performance();
+            return performance(nodes.at(n_id));
         });
 
         return ids;
@@ -60,8 +76,8 @@ public:
         return std::ranges::max_element(
             valid_nodes,
             {},
-            [] (cluster_node const & node) {
-                return node.performance();
+            [this] (cluster_node const & node) {
+                return performance(node);
             }
         )->id;
     }
@@ -76,8 +92,8 @@ public:
         return std::ranges::min_element(
             valid_nodes,
             {},
-            [] (cluster_node const & node) {
-                return node.performance();
+            [this] (cluster_node const & node) {
+                return performance(node);
             }
         )->id;
     }
@@ -88,8 +104,8 @@ public:
             end(),
             0.0,
             std::plus<>(),
-            [] (auto const & n) {
-                return n.performance();
+            [this] (auto const & n) {
+                return performance(n);
             }
         );
 
@@ -98,21 +114,47 @@ public:
 
     double best_performance() const {
         // safe dereference because cluster size enforced to be > 0
-        return std::ranges::max_element(
+        return performance(*std::ranges::max_element(
             nodes,
             {},
-            [] (cluster_node const & node) {
-                return node.performance();
+            [this] (cluster_node const & node) {
+                return performance(node);
             }
-        )->performance();
+        ));
     }
 
-    // assumes that all bandwidth are equal (as of this writing this is always the case)
+    // only meaningful if has_uniform_bandwidth()
     double uniform_bandwidth() const {
         return nodes.front().network_bandwidth;
     }
 
+    bool has_uniform_bandwidth() const {
+        return !link_bandwidths && std::ranges::all_of(nodes, [this] (cluster_node const & node) {
+            return node.network_bandwidth == uniform_bandwidth();
+        });
+    }
+
+    bool has_link_bandwidths() const {
+        return link_bandwidths.has_value();
+    }
+
+    bandwidth_matrix const & get_link_bandwidths() const {
+        if (!link_bandwidths) {
+            throw std::runtime_error("Internal bug: the cluster has no link bandwidths.");
+        }
+
+        return link_bandwidths.value();
+    }
+
+    std::optional<core_model> const & get_core_model() const {
+        return cores;
+    }
+
     double mean_bandwidth() const {
+        if (link_bandwidths) {
+            return link_bandwidths->mean_bandwidth();
+        }
+
         double const performance_sum = std::transform_reduce(
             begin(), 
             end(),
@@ -133,6 +175,12 @@ public:
         for(cluster_node const & node : nodes) {
             out << node.to_string() << '\n';
         }
+        if (link_bandwidths) {
+            out << link_bandwidths->to_string();
+        }
+        if (cores) {
+            out << cores->to_string() << '\n';
+        }
         out << '\n';
 
         return out.str();
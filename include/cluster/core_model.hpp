@@ -0,0 +1,71 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <sstream>
+#include <string>
+
+#include <cluster/cluster_node.hpp>
+
+namespace cluster {
+
+// every task runs on a subset of the cores of its node instead of the whole node, a task on k
+// cores is faster than on one core by Amdahl's law, tasks on the same node may run at the same
+// time as long as they don't use more cores than the node has
+struct core_model {
+    // share of the workload of every task that can run in parallel, 0 means single-threaded tasks
+    double parallel_fraction;
+    // 0 means all cores of the node
+    size_t max_cores_per_task;
+    // 0 means no limit, otherwise a task doesn't use more cores than it can use with at least
+    // this parallel efficiency, i.e. k * amdahl_factor(k) <= 1 / min_efficiency, so the first
+    // tasks of a greedy insertion can't take all cores for a small speedup
+    double min_efficiency{0.0};
+
+    // the maximum number of cores without the efficiency limit
+    size_t max_cores_per_task_on(cluster_node const & node) const {
+        return max_cores_per_task == 0 ? node.num_cores : std::min(max_cores_per_task, node.num_cores);
+    }
+
+    size_t max_cores(cluster_node const & node) const {
+        size_t cores = max_cores_per_task_on(node);
+
+        if (min_efficiency > 0.0 && parallel_fraction < 1.0) {
+            double const max_efficient_cores = (1.0 / min_efficiency - parallel_fraction) / (1.0 - parallel_fraction);
+            cores = std::min(cores, static_cast<size_t>(max_efficient_cores));
+        }
+
+        return std::max(cores, size_t{1});
+    }
+
+    // computation time on the given number of cores relative to the time on one core
+    double amdahl_factor(size_t const cores) const {
+        return (1.0 - parallel_fraction) + parallel_fraction / static_cast<double>(cores);
+    }
+
+    // performance for a task that uses the maximum number of cores of the node
+    double performance(cluster_node const & node) const {
+        return node.core_performance / amdahl_factor(max_cores(node));
+    }
+
+    std::string to_string() const {
+        std::stringstream out{};
+
+        out << "Core model: parallel fraction " << parallel_fraction
+            << ", max cores per task ";
+
+        if (max_cores_per_task == 0) {
+            out << "all";
+        } else {
+            out << max_cores_per_task;
+        }
+
+        if (min_efficiency > 0.0) {
+            out << ", min efficiency " << min_efficiency;
+        }
+
+        return out.str();
+    }
+};
+
+} // namespace cluster
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <concepts>
+#include <vector>
+
+#include <cluster/bandwidth_matrix.hpp>
+#include <cluster/cluster.hpp>
+#include <cluster/cluster_node.hpp>
+#include <util/timepoint.hpp>
+
+namespace cluster {
+
+// compile-time policy that defines how long a workload runs on a node and how long it takes
+// to transfer data between two nodes, the schedule and the algorithms are parametrized with it
+template <typename M>
+concept cost_model = std::constructible_from<M, cluster const &>
+    && requires (M const & m, double const amount, node_id const n_id) {
+        { m.computation_time(amount, n_id) } -> std::same_as<util::timepoint>;
+
+        // no cost if both nodes are the same
+        { m.data_transfer_cost(amount, n_id, n_id) } -> std::same_as<util::timepoint>;
+
+        // cost of sending data over the link between the nodes even if they are the same
+        { m.raw_data_transfer_cost(amount, n_id, n_id) } -> std::same_as<util::timepoint>;
+    };
+
+// all links have the same bandwidth, the reciprocals of the bandwidth and the node
+// performances are precomputed such that a cost evaluation has no division and no branch
+class uniform_cost_model {
+    std::vector<double> inverse_performances;
+    double inverse_bandwidth;
+
+public:
+    explicit uniform_cost_model(cluster const & c)
+        : inverse_performances(c.size()), inverse_bandwidth{1.0 / c.uniform_bandwidth()} {
+        for (cluster_node const & node : c) {
+            inverse_performances[node.id] = 1.0 / node.performance();
+        }
+    }
+
+    util::timepoint computation_time(double const workload, node_id const n_id) const {
+        return workload * inverse_performances[n_id];
+    }
+
+    util::timepoint data_transfer_cost(
+        double const data_transfer,
+        node_id const from_n_id,
+        node_id const to_n_id
+    ) const {
+        // multiplying with the comparison result instead of branching keeps loops vectorizable
+        return data_transfer * inverse_bandwidth * static_cast<double>(from_n_id != to_n_id);
+    }
+
+    util::timepoint raw_data_transfer_cost(
+        double const data_transfer,
+        [[maybe_unused]] node_id const from_n_id,
+        [[maybe_unused]] node_id const to_n_id
+    ) const {
+        return data_transfer * inverse_bandwidth;
+    }
+};
+
+// every node sends its data with its own network bandwidth
+class node_bandwidth_cost_model {
+    std::vector<double> inverse_performances;
+    std::vector<double> inverse_bandwidths;
+
+public:
+    explicit node_bandwidth_cost_model(cluster const & c)
+        : inverse_performances(c.size()), inverse_bandwidths(c.size()) {
+        for (cluster_node const & node : c) {
+            inverse_performances[node.id] = 1.0 / node.performance();
+            inverse_bandwidths[node.id] = 1.0 / node.network_bandwidth;
+        }
+    }
+
+    util::timepoint computation_time(double const workload, node_id const n_id) const {
+        return workload * inverse_performances[n_id];
+    }
+
+    util::timepoint data_transfer_cost(
+        double const data_transfer,
+        node_id const from_n_id,
+        node_id const to_n_id
+    ) const {
+        return data_transfer * inverse_bandwidths[from_n_id] * static_cast<double>(from_n_id != to_n_id);
+    }
+
+    util::timepoint raw_data_transfer_cost(
+        double const data_transfer,
+        node_id const from_n_id,
+        [[maybe_unused]] node_id const to_n_id
+    ) const {
+        return data_transfer * inverse_bandwidths[from_n_id];
+    }
+};
+
+// every pair of nodes has its own link, the inverse bandwidths are stored per pair of node groups
+class link_bandwidth_cost_model {
+    std::vector<double> inverse_performances;
+    std::vector<size_t> group_of_node;
+    size_t num_groups;
+    // row-major num_groups x num_groups
+    std::vector<double> inverse_group_bandwidths;
+
+public:
+    explicit link_bandwidth_cost_model(cluster const & c)
+        : inverse_performances(c.size()), group_of_node(c.size()) {
+        bandwidth_matrix const & links = c.get_link_bandwidths();
+        num_groups = links.get_num_groups();
+        inverse_group_bandwidths.resize(num_groups * num_groups);
+
+        for (cluster_node const & node : c) {
+            inverse_performances[node.id] = 1.0 / node.performance();
+            group_of_node[node.id] = links.group(node.id);
+        }
+
+        for (size_t from_group = 0; from_group < num_groups; ++from_group) {
+            for (size_t to_group = 0; to_group < num_groups; ++to_group) {
+                inverse_group_bandwidths[from_group * num_groups + to_group] = 
+                    1.0 / links.group_bandwidth(from_group, to_group);
+            }
+        }
+    }
+
+    util::timepoint computation_time(double const workload, node_id const n_id) const {
+        return workload * inverse_performances[n_id];
+    }
+
+    util::timepoint data_transfer_cost(
+        double const data_transfer,
+        node_id const from_n_id,
+        node_id const to_n_id
+    ) const {
+        return raw_data_transfer_cost(data_transfer, from_n_id, to_n_id) 
+            * static_cast<double>(from_n_id != to_n_id);
+    }
+
+    util::timepoint raw_data_transfer_cost(
+        double const data_transfer,
+        node_id const from_n_id,
+        node_id const to_n_id
+    ) const {
+        size_t const index = group_of_node[from_n_id] * num_groups + group_of_node[to_n_id];
+        return data_transfer * inverse_group_bandwidths[index];
+    }
+};
+
+// calls func with an instance of the cheapest cost model that is exact for the given cluster,
+// func should be generic in the cost model type, e.g. [] <cost_model M> (M const & model) {}
+template <typename F>
+void visit_cost_model(cluster const & c, F && func) {
+    if (c.has_link_bandwidths()) {
+        func(link_bandwidth_cost_model(c));
+    } else if (c.has_uniform_bandwidth()) {
+        func(uniform_cost_model(c));
+    } else {
+        func(node_bandwidth_cost_model(c));
+    }
+}
+
+} // namespace cluster
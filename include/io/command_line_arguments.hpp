@@ -1,23 +1,70 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 namespace io {
 
 struct command_line_arguments {
     std::string cluster_input{};
+    std::string rack_input{};
+    std::string link_input{};
     std::string task_bag_input{};
+    std::string workflow_list_input{};
     std::string dependency_input{};
     std::string topology{};
 
     std::string task_to_node_assignment_input{};
 
     std::string select_algorithm{};
+    bool portfolio{false};
+    bool online{false};
+    // requests over the standard input or the socket if a path is given, 0 workers means one per
+    // hardware thread
+    bool daemon{false};
+    std::string socket_path{};
+    size_t daemon_workers{0};
+    // 0 means no time budget
+    size_t time_budget_ms{0};
+
+    // the local search runs only if one of both is not 0
+    size_t improve_time_ms{0};
+    size_t improve_iterations{0};
+
+    // the genetic algorithm stops at whichever limit is reached first, 0 means no limit
+    size_t ga_generations{50};
+    size_t ga_time_ms{0};
+
+    // every task runs on 1 to max_cores_per_task cores of its node with Amdahl's law,
+    // 0 means all cores of the node, a min_efficiency of 0 means no efficiency limit
+    bool core_model{false};
+    double parallel_fraction{0.0};
+    size_t max_cores_per_task{0};
+    double min_efficiency{0.0};
+
+    // every computed schedule is repaired for these changes, the updates are task_id:workload and
+    // the dependencies from_id:to_id:data_transfer
+    bool fail_node{false};
+    size_t failed_node_id{0};
+    std::vector<std::string> workload_updates{};
+    std::vector<std::string> added_dependencies{};
 
     std::string output{};
     bool verbose{false};
 
+    std::string export_prefix{};
+    std::string export_format{"csv"};
+
+    // summary or json, no analytics if empty
+    std::string analytics_format{};
+
+    // the trace is only recorded if tracing was compiled in
+    std::string trace_output{};
+    bool trace_tasks{false};
+
     bool use_memory_requirements{false};
+    bool skip_validation{false};
 };
 
 } // namespace io
@@ -0,0 +1,312 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cluster/cost_model.hpp>
+#include <io/command_line_arguments.hpp>
+#include <schedule/schedule.hpp>
+#include <schedule/time_interval.hpp>
+#include <util/epsilon_compare.hpp>
+#include <workflow/task.hpp>
+#include <workflow/workflow.hpp>
+
+namespace io {
+
+enum class export_format {
+    csv, binary, trace
+};
+
+inline export_format export_format_from_string(std::string const & s) {
+    if (s == "csv") {
+        return export_format::csv;
+    } else if (s == "binary") {
+        return export_format::binary;
+    } else if (s == "trace") {
+        return export_format::trace;
+    }
+
+    throw std::runtime_error("The given export format has an invalid or unknown value.");
+}
+
+inline std::string file_extension(export_format const format) {
+    switch (format) {
+        case export_format::csv: return ".csv";
+        case export_format::binary: return ".bin";
+        case export_format::trace: return ".json";
+        default: throw std::runtime_error("Internal bug: unknown export format.");
+    }
+}
+
+// fixed width record of the binary export format, written in native byte order
+struct binary_schedule_record {
+    std::uint64_t task_id;
+    std::uint64_t node_id;
+    double start;
+    double end;
+    std::uint64_t is_duplicate;
+};
+
+static_assert(sizeof(binary_schedule_record) == 40, "Binary schedule records must be 40 bytes wide.");
+
+inline void write_csv_header(std::ostream & out) {
+    out << std::setprecision(std::numeric_limits<double>::max_digits10);
+    out << "task_id,node_id,start,end,is_duplicate\n";
+}
+
+// single records are also written by the online mode as soon as a task is placed,
+// the trace format has no single records
+inline void write_schedule_record(
+    std::ostream & out,
+    export_format const format,
+    workflow::task_id const t_id,
+    schedule::time_interval const & interval,
+    bool const is_duplicate
+) {
+    if (format == export_format::csv) {
+        out << t_id << ',' << interval.node_id << ','
+            << interval.start << ',' << interval.end << ','
+            << (is_duplicate ? 1 : 0) << '\n';
+        return;
+    }
+
+    binary_schedule_record const record{
+        t_id,
+        interval.node_id,
+        interval.start,
+        interval.end,
+        is_duplicate ? 1u : 0u
+    };
+
+    out.write(reinterpret_cast<char const *>(&record), sizeof(record));
+}
+
+// slices and flows are written in microseconds, such that one time unit of the schedule
+// is shown as one second
+inline double to_trace_time(util::timepoint const t) {
+    return t * 1'000'000.0;
+}
+
+// both exporters write one record per interval while iterating over the schedule,
+// so they need constant extra memory regardless of the schedule size
+template <cluster::cost_model M>
+void export_schedule_csv(std::ostream & out, schedule::schedule<M> const & sched) {
+    write_csv_header(out);
+
+    sched.for_each_interval([&out] (
+        workflow::task_id const t_id,
+        schedule::time_interval const & interval,
+        bool const is_duplicate
+    ) {
+        write_schedule_record(out, export_format::csv, t_id, interval, is_duplicate);
+    });
+}
+
+template <cluster::cost_model M>
+void export_schedule_binary(std::ostream & out, schedule::schedule<M> const & sched) {
+    sched.for_each_interval([&out] (
+        workflow::task_id const t_id,
+        schedule::time_interval const & interval,
+        bool const is_duplicate
+    ) {
+        write_schedule_record(out, export_format::binary, t_id, interval, is_duplicate);
+    });
+}
+
+// the slices of one track must nest, so the intervals of a node that overlap in the core model are
+// distributed over lanes of the node, every interval gets the first lane that is free at its start
+struct trace_lanes {
+    // scheduled task id -> lane on its node
+    std::vector<size_t> lane_of_interval{};
+    // node id -> number of lanes, at least 1
+    std::vector<size_t> num_lanes{};
+    size_t max_num_lanes{1};
+
+    // the first lane of a node keeps the node id as tid, the others are numbered after all nodes
+    std::vector<size_t> first_extra_tid{};
+
+    size_t tid(cluster::node_id const n_id, size_t const lane) const {
+        return lane == 0 ? n_id : first_extra_tid[n_id] + lane - 1;
+    }
+
+    size_t tid(schedule::time_interval const & interval) const {
+        return tid(interval.node_id, lane_of_interval[interval.task_id]);
+    }
+};
+
+template <cluster::cost_model M>
+trace_lanes compute_trace_lanes(schedule::schedule<M> const & sched) {
+    trace_lanes lanes{};
+    lanes.num_lanes.assign(sched.num_nodes(), 1);
+
+    // node id -> end of the last interval of every lane, the intervals of a node are sorted by start
+    std::vector<std::vector<util::timepoint>> lane_ends(sched.num_nodes());
+
+    sched.for_each_interval([&lanes, &lane_ends] (
+        [[maybe_unused]] workflow::task_id const t_id,
+        schedule::time_interval const & interval,
+        [[maybe_unused]] bool const is_duplicate
+    ) {
+        auto & ends = lane_ends[interval.node_id];
+        auto const free_it = std::ranges::find_if(ends, [&interval] (util::timepoint const end) {
+            return util::epsilon_less_or_eq(end, interval.start);
+        });
+
+        size_t const lane = static_cast<size_t>(free_it - ends.begin());
+        if (free_it == ends.end()) {
+            ends.push_back(interval.end);
+        } else {
+            *free_it = interval.end;
+        }
+
+        if (interval.task_id >= lanes.lane_of_interval.size()) {
+            lanes.lane_of_interval.resize(interval.task_id + 1, 0);
+        }
+
+        lanes.lane_of_interval[interval.task_id] = lane;
+        lanes.num_lanes[interval.node_id] = std::max(lanes.num_lanes[interval.node_id], lane + 1);
+    });
+
+    size_t next_tid = sched.num_nodes();
+    lanes.first_extra_tid.resize(sched.num_nodes());
+
+    for (cluster::node_id n_id = 0; n_id < sched.num_nodes(); ++n_id) {
+        lanes.first_extra_tid[n_id] = next_tid;
+        next_tid += lanes.num_lanes[n_id] - 1;
+        lanes.max_num_lanes = std::max(lanes.max_num_lanes, lanes.num_lanes[n_id]);
+    }
+
+    return lanes;
+}
+
+// Chrome trace-event json that can be opened in Perfetto, every node is a track (tid = node id)
+// with one slice per interval that is named after the task id, in the core model the overlapping
+// intervals of a node are put on further tracks of the node, every data transfer between two
+// nodes is a flow arrow from the interval of the predecessor to the interval of the task,
+// the events are written while iterating over the schedule like the other exporters
+template <cluster::cost_model M>
+void export_schedule_trace(
+    std::ostream & out,
+    schedule::schedule<M> const & sched,
+    workflow::workflow const & w,
+    std::string const & algo_str
+) {
+    trace_lanes const lanes = compute_trace_lanes(sched);
+
+    out << std::setprecision(std::numeric_limits<double>::max_digits10);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+        << "\"args\":{\"name\":\"" << algo_str << " schedule\"}}";
+
+    for (cluster::node_id n_id = 0; n_id < sched.num_nodes(); ++n_id) {
+        for (size_t lane = 0; lane < lanes.num_lanes[n_id]; ++lane) {
+            out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << lanes.tid(n_id, lane)
+                << ",\"args\":{\"name\":\"node " << n_id;
+
+            if (lane != 0) {
+                out << " (" << lane << ')';
+            }
+
+            out << "\"}}";
+            out << ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":" << lanes.tid(n_id, lane)
+                << ",\"args\":{\"sort_index\":" << n_id * lanes.max_num_lanes + lane << "}}";
+        }
+    }
+
+    sched.for_each_interval([&out, &lanes] (
+        workflow::task_id const t_id,
+        schedule::time_interval const & interval,
+        bool const is_duplicate
+    ) {
+        out << ",\n{\"name\":\"" << t_id << "\",\"cat\":\"" << (is_duplicate ? "duplicate" : "task")
+            << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << lanes.tid(interval)
+            << ",\"ts\":" << to_trace_time(interval.start)
+            << ",\"dur\":" << to_trace_time(interval.end - interval.start)
+            << ",\"args\":{\"task_id\":" << t_id << ",\"cores\":" << interval.cores << "}}";
+    });
+
+    // a flow starts where the data is sent, i.e. at the end of the predecessor slice, and ends at
+    // the start of the successor slice, the start is placed 1 ns before the end, because a flow
+    // event is only bound to a slice that encloses its timestamp
+    double constexpr bind_offset = 0.001;
+    size_t flow_id = 0;
+
+    sched.for_each_different_node_edge(w, [&out, &flow_id, &lanes] (
+        workflow::task_id const pred_t_id,
+        schedule::time_interval const & pred_interval,
+        workflow::task_id const t_id,
+        schedule::time_interval const & interval
+    ) {
+        double const send_time = std::max(
+            to_trace_time(pred_interval.end) - bind_offset,
+            to_trace_time(pred_interval.start)
+        );
+
+        out << ",\n{\"name\":\"" << pred_t_id << " -> " << t_id
+            << "\",\"cat\":\"transfer\",\"ph\":\"s\",\"id\":" << flow_id
+            << ",\"pid\":1,\"tid\":" << lanes.tid(pred_interval)
+            << ",\"ts\":" << send_time << '}';
+        out << ",\n{\"name\":\"" << pred_t_id << " -> " << t_id
+            << "\",\"cat\":\"transfer\",\"ph\":\"f\",\"bp\":\"e\",\"id\":" << flow_id
+            << ",\"pid\":1,\"tid\":" << lanes.tid(interval)
+            << ",\"ts\":" << to_trace_time(interval.start) << '}';
+        ++flow_id;
+    });
+
+    out << "\n]}\n";
+}
+
+// <export prefix>_<algorithm>.<csv|bin|json>
+inline std::ofstream open_export_file(std::string const & algo_str, command_line_arguments const & args) {
+    export_format const format = export_format_from_string(args.export_format);
+
+    auto lower = algo_str | std::views::transform([] (unsigned char const c) {
+        return std::tolower(c);
+    });
+    std::string const filename = args.export_prefix + '_'
+        + std::string(lower.begin(), lower.end()) + file_extension(format);
+
+    std::ofstream fout(filename, std::ios::out | std::ios::trunc | std::ios::binary);
+
+    if (fout.fail() || !fout.is_open()) {
+        throw std::runtime_error("Could not open the export file " + filename);
+    }
+
+    return fout;
+}
+
+// writes the schedule to <export prefix>_<algorithm>.<csv|bin|json> if an export prefix was given
+template <cluster::cost_model M>
+void handle_schedule_export(
+    std::string const & algo_str,
+    command_line_arguments const & args,
+    schedule::schedule<M> const & sched,
+    workflow::workflow const & w
+) {
+    if (args.export_prefix.empty()) {
+        return;
+    }
+
+    export_format const format = export_format_from_string(args.export_format);
+
+    std::ofstream fout = open_export_file(algo_str, args);
+
+    if (format == export_format::csv) {
+        export_schedule_csv(fout, sched);
+    } else if (format == export_format::binary) {
+        export_schedule_binary(fout, sched);
+    } else {
+        export_schedule_trace(fout, sched, w, algo_str);
+    }
+}
+
+} // namespace io
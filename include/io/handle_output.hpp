@@ -3,6 +3,7 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <optional>
 #include <ranges>
 #include <sstream>
 #include <stdexcept>
@@ -10,6 +11,8 @@
 #include <vector>
 
 #include <io/command_line_arguments.hpp>
+#include <io/export_schedule.hpp>
+#include <schedule/analytics.hpp>
 #include <schedule/schedule.hpp>
 #include <workflow/workflow.hpp>
 
@@ -17,27 +20,31 @@
 
 namespace io {
 
-void handle_output_str(command_line_arguments const & args, std::string const & out_str) {
-    if (!args.verbose && args.output.empty()) {
+inline void handle_output_str(bool const verbose, std::string const & output, std::string const & out_str) {
+    if (!verbose && output.empty()) {
         return;
     }
 
-    if (args.verbose) {
+    if (verbose) {
         std::cout << out_str;
         std::cout.flush();
     }
 
-    if (!args.output.empty()) {
-        std::ofstream fout(args.output, std::ios::app | std::ios::out);
+    if (!output.empty()) {
+        std::ofstream fout(output, std::ios::app | std::ios::out);
 
         if (fout.fail() || !fout.is_open()) {
-            throw std::runtime_error("Could not open the output file " + args.output);
+            throw std::runtime_error("Could not open the output file " + output);
         }
 
         fout << out_str;
     }
 }
 
+inline void handle_output_str(command_line_arguments const & args, std::string const & out_str) {
+    handle_output_str(args.verbose, args.output, out_str);
+}
+
 template<typename T, typename... Args>
 void handle_output_obj(command_line_arguments const & args, T const & out_obj, Args&&... to_str_params) {
     std::string out_str = out_obj.to_string(to_str_params...);
@@ -45,7 +52,7 @@ void handle_output_obj(command_line_arguments const & args, T const & out_obj, A
     handle_output_str(args, out_str);
 }
 
-void print_node_communication_matrix(
+inline void print_node_communication_matrix(
     command_line_arguments const & args,
     std::vector<std::vector<double>> const & node_communication,
     std::string const & algo_str
@@ -89,27 +96,50 @@ void print_node_communication_matrix(
     io::handle_output_str(args, outer_table.str() += "\n\n");
 }
 
+template <cluster::cost_model M>
 void handle_computed_schedule_output(
     std::string const & algo_str,
     std::string const formatted_cpu_time,
     command_line_arguments const & args,
-    schedule::schedule const & sched,
+    schedule::schedule<M> const & sched,
     workflow::workflow const & w
 ) {
-    bool const valid = sched.is_valid(w);
-
+    std::optional<bool> valid_opt{};
+    std::string validity_str = "(not validated)";
+    std::vector<std::vector<double>> node_communication{};
+
+    if (!args.skip_validation) {
+        auto validation = sched.validate(w);
+        valid_opt = validation.valid;
+        validity_str = validation.valid ? "(valid)" : "(NOT valid)";
+        node_communication = std::move(validation.node_communication);
+    }
 
-    io::handle_output_obj(args, sched, algo_str, valid);
+    io::handle_output_obj(args, sched, algo_str, valid_opt);
     io::handle_output_str(args, algo_str + " -- CPU running time: " + formatted_cpu_time + "\n\n");
 
     if (!args.verbose) {
         std::cout << algo_str << " makespan: " << sched.get_makespan() << ' '
-            << (valid ? "(" : "(NOT ") << "valid) -- CPU running time: " 
+            << validity_str << " -- CPU running time: " 
             << formatted_cpu_time << '\n';
     }
 
-    if (valid) {
-        auto const node_communication = sched.compute_node_communication_matrix(w);
+    if (!args.analytics_format.empty()) {
+        schedule::schedule_analytics const analytics = schedule::analyze(sched, w);
+        std::string const analytics_str = args.analytics_format == "json"
+            ? analytics.to_json(algo_str) + '\n'
+            : analytics.to_string(algo_str);
+
+        handle_output_str(args, analytics_str + '\n');
+
+        if (!args.verbose) {
+            std::cout << analytics_str;
+        }
+    }
+
+    handle_schedule_export(algo_str, args, sched, w);
+
+    if (valid_opt.value_or(false)) {
         print_node_communication_matrix(args, node_communication, algo_str);
     }
 }
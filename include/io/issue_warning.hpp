@@ -7,15 +7,19 @@
 
 namespace io {
 
-void issue_warning(command_line_arguments const & args, std::string const & str) {
+inline void issue_warning(bool const verbose, std::string const & output, std::string const & str) {
     std::string const warning_str = "----- WARNING ---> " + str + '\n';
     
-    handle_output_str(args, warning_str + '\n');
+    handle_output_str(verbose, output, warning_str + '\n');
 
-    if (!args.verbose) {
+    if (!verbose) {
         std::cout << warning_str;
         std::cout.flush();
     }
 }
 
+inline void issue_warning(command_line_arguments const & args, std::string const & str) {
+    issue_warning(args.verbose, args.output, str);
+}
+
 } // namespace io
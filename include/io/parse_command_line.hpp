@@ -9,12 +9,17 @@
 
 namespace io {
 
-std::optional<command_line_arguments> parse_command_line(int argc, char *argv[]) {
+inline std::optional<command_line_arguments> parse_command_line(int argc, char *argv[]) {
     using namespace clipp;
     command_line_arguments args{};
 
     auto cluster_option = required("-c", "--cluster") & value("cluster_file", args.cluster_input);
-    auto task_bags_option = required("-t", "--tasks") & value("tasks_file", args.task_bag_input);
+    // either the tasks of one workflow or a list of workflows is required
+    auto task_bags_option = option("-t", "--tasks") & value("tasks_file", args.task_bag_input);
+    auto workflows_option = option("-w", "--workflows") & value("workflow_list_file", args.workflow_list_input);
+
+    auto rack_option = option("-r", "--racks") & value("racks_file", args.rack_input);
+    auto link_option = option("-l", "--links") & value("links_file", args.link_input);
     
     auto dependency_option = option("-d", "--dependencies") & value("dependencies_file", args.dependency_input);
     auto topology_option = option("-p", "--topology") & value("topology", args.topology);
@@ -25,20 +30,77 @@ std::optional<command_line_arguments> parse_command_line(int argc, char *argv[])
     auto select_algorithm_option = option("-s", "--select-algorithm") 
         & value("algorithm", args.select_algorithm);
 
+    auto portfolio_option = option("--portfolio").set(args.portfolio);
+    auto online_option = option("--online").set(args.online);
+    auto daemon_option = option("--daemon").set(args.daemon);
+    auto socket_option = option("--socket") & value("socket_path", args.socket_path);
+    auto daemon_workers_option = option("--workers") & value("workers", args.daemon_workers);
+    auto time_budget_option = option("--time-budget") & value("ms", args.time_budget_ms);
+
+    auto improve_time_option = option("--improve-time") & value("ms", args.improve_time_ms);
+    auto improve_iterations_option = option("--improve-iterations") 
+        & value("iterations", args.improve_iterations);
+
+    auto ga_generations_option = option("--ga-generations") & value("generations", args.ga_generations);
+    auto ga_time_option = option("--ga-time") & value("ms", args.ga_time_ms);
+
+    auto core_model_option = option("--core-model").set(args.core_model);
+    auto parallel_fraction_option = option("--parallel-fraction") & value("fraction", args.parallel_fraction);
+    auto max_cores_option = option("--max-cores-per-task") & value("cores", args.max_cores_per_task);
+    auto min_efficiency_option = option("--min-efficiency") & value("efficiency", args.min_efficiency);
+
+    auto fail_node_option = option("--fail-node").set(args.fail_node) 
+        & value("node_id", args.failed_node_id);
+    auto update_workload_option = repeatable(option("--update-workload") 
+        & value("task_id:workload", args.workload_updates));
+    auto add_dependency_option = repeatable(option("--add-dependency") 
+        & value("from_id:to_id:data_transfer", args.added_dependencies));
+
     auto output_option = option("-o", "--output") & value("output_file", args.output);
     auto verbose_option = option("-v", "--verbose").set(args.verbose);
 
+    auto export_option = option("-e", "--export") & value("export_prefix", args.export_prefix);
+    auto export_format_option = option("-f", "--export-format") & value("format", args.export_format);
+
+    auto analytics_option = option("--analytics") & value("format", args.analytics_format);
+
+    auto trace_option = option("--trace") & value("trace_file", args.trace_output);
+    auto trace_tasks_option = option("--trace-tasks").set(args.trace_tasks);
+
     auto use_memory_option = option("-m", "--use-memory-requirements").set(args.use_memory_requirements);
+    auto no_validate_option = option("--no-validate").set(args.skip_validation);
 
     std::string const cluster_doc = (
         "File in .csv format that describes the cluster architecture. "
         "It should contain exactly the fields bandwidth, performance, memory and num_cores."
     );
+    std::string const rack_doc = (
+        "File in .csv format that groups the cluster nodes into racks. "
+        "It should contain exactly the fields first_node_id, last_node_id, intra_rack_bandwidth "
+        "and inter_rack_bandwidth. Every node must be part of exactly one rack. Data sent between "
+        "two racks uses the smaller inter_rack_bandwidth of both racks. "
+        "Replaces the bandwidth field of the cluster file for all data transfers."
+    );
+    std::string const link_doc = (
+        "File in .csv format that describes the bandwidth of individual links between two "
+        "cluster nodes. It should contain exactly the fields from_id, to_id and bandwidth. "
+        "Links are symmetric. Links that are not given use the smaller bandwidth of both nodes "
+        "from the cluster file. Can't be combined with a racks file."
+    );
     std::string const task_bags_doc = (
         "File in .csv format that describes the tasks of the workflow. "
         "It should contain exactly the fields workload, input_data_size, output_data_size, "
         "memory and cardinality. "
     );
+    std::string const workflows_doc = (
+        "File in .csv format that lists several workflows which are scheduled jointly onto the "
+        "cluster instead of the workflow of the tasks file. It should contain exactly the fields "
+        "task_bags, topology, dependencies, release_time and priority. The first three fields are "
+        "the inputs of one workflow as for -t, -p and -d (dependencies may be empty), paths are "
+        "relative to the list file. No task starts before the release time of its workflow and "
+        "workflows with a higher priority are scheduled first. Can't be combined with a tasks file, "
+        "selecting an algorithm, the portfolio mode, the online mode or an assignment file."
+    );
     std::string const dependency_doc = (
         "File that contains the dependencies for the workflow tasks. " 
         "Can either be in csv format or in xml format. "
@@ -59,8 +121,107 @@ std::optional<command_line_arguments> parse_command_line(int argc, char *argv[])
     );
     std::string const select_algorithm_doc = (
         "If this is given, only the selected algorithm is executed. "
-        "Must be one of: heft, cpop, rbca, dbca or none. "
-        "If 'none' is given, no algorithm is executed."
+        "Must be one of: heft, cpop, rbca, dbca, tdca, peft, lookahead_heft, genetic or none. "
+        "If 'none' is given, no algorithm is executed. Otherwise all algorithms except genetic are "
+        "executed."
+    );
+    std::string const portfolio_doc = (
+        "If given, all algorithms except genetic are executed in parallel and only the schedule with "
+        "the lowest makespan is emitted together with the algorithm that computed it. "
+        "Can't be combined with selecting an algorithm."
+    );
+    std::string const online_doc = (
+        "If given, the task bags are scheduled one after another as they arrive from the task bag "
+        "file (use - for the standard input), which may be a pipe. The dependencies are inferred "
+        "from the topology if one is given and read from lines 'dependency, <from_id>, <to_id>' "
+        "between the bags (0-based task ids over all bags in the order of their arrival), which must "
+        "arrive before the bag of their target task. A topology with complex bag dependencies "
+        "(montage) can't be given, all of its dependencies must be streamed as such lines instead. "
+        "Every task is placed onto the node with its earliest finish time and "
+        "the placements of each bag are streamed right away in the export format to the export file "
+        "<export_prefix>_online.<csv|bin> or to the command line. "
+        "Can't be combined with selecting an algorithm, the portfolio mode or an assignment file."
+    );
+    std::string const daemon_doc = (
+        "If given, the cluster is loaded once and scheduling requests are answered until the input "
+        "ends or a client sends shutdown. Every request is one line of space separated key=value "
+        "fields: algorithm and tasks are required, topology, dependencies, cluster, racks, links, "
+        "memory (0 or 1), records (0 or 1) and id are optional, the cluster of -c is used if no cluster "
+        "is given. Loaded clusters, workflows and their ranks are kept for later requests. Every "
+        "response starts with a line 'result id=<id> algorithm=<algorithm> makespan=<makespan> "
+        "valid=<0|1|-> microseconds=<time> records=<n>' followed by n csv records with the fields "
+        "task_id, node_id, start, end and is_duplicate, or consists of the line 'error id=<id> "
+        "message=<message>'. Responses are sent as soon as they are computed and may arrive in a "
+        "different order than the requests. Can't be combined with a tasks file, a workflow list, "
+        "selecting an algorithm, the portfolio mode, the online mode or an assignment file."
+    );
+    std::string const socket_doc = (
+        "Path of a Unix domain socket on which the daemon accepts clients instead of reading the "
+        "requests from the standard input. Every client gets the responses to its own requests."
+    );
+    std::string const daemon_workers_doc = (
+        "Number of worker threads of the daemon. Defaults to 0 which means one per hardware thread."
+    );
+    std::string const time_budget_doc = (
+        "Time budget in milliseconds for the portfolio mode. Algorithms that are still running "
+        "afterwards are stopped, TDCA then skips its remaining improvement phases. "
+        "Defaults to 0 which means no time budget."
+    );
+    std::string const improve_time_doc = (
+        "If given, every computed schedule (also the one of an assignment file) is improved by a "
+        "local search with task migration and swap moves for at most this many milliseconds. "
+        "The improved schedule is reported as <algorithm>_IMPROVED."
+    );
+    std::string const improve_iterations_doc = (
+        "If given, the local search stops after this many moves. Can be combined with a time limit, "
+        "the search then stops at whichever limit is reached first."
+    );
+    std::string const ga_generations_doc = (
+        "Maximum number of generations of the genetic algorithm. Defaults to 50. "
+        "0 means no limit, which requires a time limit."
+    );
+    std::string const ga_time_doc = (
+        "Maximum running time of the genetic algorithm in milliseconds without its seeds "
+        "HEFT, CPOP and RBCA. Defaults to 0 which means no time limit."
+    );
+    std::string const fail_node_doc = (
+        "If given, every computed schedule is repaired for the failure of this (0-based) node. "
+        "Only the tasks of the node and their successors are rescheduled onto the remaining nodes. "
+        "The repaired schedule is reported as <algorithm>_REPAIRED."
+    );
+    std::string const update_workload_doc = (
+        "If given, every computed schedule is repaired for the new workload of this (0-based) task, "
+        "e.g. 12:350.5. Can be given several times and combined with a failed node and added "
+        "dependencies. Only the changed tasks and their successors are rescheduled."
+    );
+    std::string const add_dependency_doc = (
+        "If given, every computed schedule is repaired for this new dependency between two (0-based) "
+        "tasks with the given data transfer, e.g. 3:17:20. Can be given several times, the "
+        "dependency must not create a cycle. Only the target task and its successors are rescheduled."
+    );
+    std::string const core_model_doc = (
+        "If given, every task runs on a subset of the cores of its node instead of the whole node "
+        "(the performance field of the cluster file is the performance of one core). "
+        "Tasks on the same node may overlap as long as they don't use more cores than the node has. "
+        "Every task is placed into the slot (node, start time and number of cores) with its earliest "
+        "finish time, the numbers of cores that are considered are the powers of two up to the "
+        "maximum and the maximum itself. The genetic algorithm and the local search evaluate their "
+        "candidates without the core model."
+    );
+    std::string const parallel_fraction_doc = (
+        "Share of the workload of every task that can run in parallel in the core model. The "
+        "computation time on k cores is (1 - fraction + fraction / k) times the time on one core "
+        "(Amdahl's law). Defaults to 0 which means single-threaded tasks that use one core."
+    );
+    std::string const max_cores_doc = (
+        "Maximum number of cores of a task in the core model. Defaults to 0 which means all cores "
+        "of the node."
+    );
+    std::string const min_efficiency_doc = (
+        "If given, no task uses more cores than it can use with at least this parallel efficiency "
+        "(speedup divided by the number of cores) in the core model, e.g. 0.5, which further lowers "
+        "the maximum number of cores per task. Otherwise the first tasks of the greedy insertion "
+        "may take all cores of a node for a small speedup. Defaults to 0 which means no limit."
     );
     std::string const output_doc = (
         "If given, the verbose output of this program is written to this file as plain text."
@@ -68,30 +229,102 @@ std::optional<command_line_arguments> parse_command_line(int argc, char *argv[])
     std::string const verbosity_doc = (
         "If given, all metrics and the full solution are printed to the command line."
     );
+    std::string const export_doc = (
+        "If given, each computed schedule is streamed to the file <export_prefix>_<algorithm>.csv "
+        "(or .bin or .json) with one record per scheduled task interval."
+    );
+    std::string const export_format_doc = (
+        "Format of the exported schedules. Must be one of: csv, binary or trace. Defaults to csv. "
+        "The csv format contains exactly the fields task_id, node_id, start, end and is_duplicate. "
+        "The binary format consists of 40 byte records in native byte order with the same fields: "
+        "task_id and node_id as 64 bit unsigned integers, start and end as 64 bit floating point "
+        "numbers and is_duplicate as a 64 bit unsigned integer. The trace format is Chrome "
+        "trace-event json (.json) for Perfetto with one track per node, one slice per task and "
+        "one flow arrow per data transfer between two nodes, one time unit is shown as one second. "
+        "In the core model, tasks that run at the same time on a node get further tracks of the node."
+    );
+    std::string const analytics_doc = (
+        "If given, the utilization and the idle gaps of every node, the communication between the "
+        "nodes and the slack of every task (latest start minus actual start without a larger "
+        "makespan) are printed for every computed schedule. Must be one of: summary (a few lines "
+        "with the busiest nodes) or json (a single line with all nodes and tasks)."
+    );
+    std::string const trace_doc = (
+        "If given, the spans of the algorithms and their phases are recorded and written to this "
+        "file as Chrome trace-event json at the end, which can be opened in Perfetto. "
+        "Requires a build with -DENABLE_TRACING=ON, otherwise nothing is recorded."
+    );
+    std::string const trace_tasks_doc = (
+        "If given, the trace also contains one span per inserted task. Makes large traces."
+    );
     std::string const use_memory_doc = (
         "If given, tasks are only scheduled onto cluster nodes with sufficient memory. "
         "This is not part of the original HEFT and CPOP and is deactivated by default."
     );
+    std::string const no_validate_doc = (
+        "If given, the computed schedules are neither validated nor is the data transfer "
+        "between the nodes computed. Useful for very large inputs."
+    );
 
     auto cli = (
         "Input" % (
             cluster_option % cluster_doc,
+            rack_option % rack_doc,
+            link_option % link_doc,
             task_bags_option % task_bags_doc,
+            workflows_option % workflows_doc,
             topology_option % topology_doc,
             dependency_option % dependency_doc,
             task_to_node_assignment_option % task_to_node_assignment_doc,
             select_algorithm_option % select_algorithm_doc
         ),
+        "Portfolio" % (
+            portfolio_option % portfolio_doc,
+            online_option % online_doc,
+            time_budget_option % time_budget_doc
+        ),
+        "Daemon" % (
+            daemon_option % daemon_doc,
+            socket_option % socket_doc,
+            daemon_workers_option % daemon_workers_doc
+        ),
+        "Improvement" % (
+            improve_time_option % improve_time_doc,
+            improve_iterations_option % improve_iterations_doc,
+            fail_node_option % fail_node_doc,
+            update_workload_option % update_workload_doc,
+            add_dependency_option % add_dependency_doc
+        ),
+        "Core model" % (
+            core_model_option % core_model_doc,
+            parallel_fraction_option % parallel_fraction_doc,
+            max_cores_option % max_cores_doc,
+            min_efficiency_option % min_efficiency_doc
+        ),
+        "Genetic algorithm" % (
+            ga_generations_option % ga_generations_doc,
+            ga_time_option % ga_time_doc
+        ),
         "Output" % (
             output_option % output_doc,
-            verbose_option % verbosity_doc
+            verbose_option % verbosity_doc,
+            export_option % export_doc,
+            export_format_option % export_format_doc,
+            analytics_option % analytics_doc
         ),
-        (use_memory_option % use_memory_doc)
+        "Tracing" % (
+            trace_option % trace_doc,
+            trace_tasks_option % trace_tasks_doc
+        ),
+        (use_memory_option % use_memory_doc),
+        (no_validate_option % no_validate_doc)
     );
 
     auto res = parse(argc, argv, cli);
 
-    if(res.any_error()) {
+    bool const has_one_input = args.task_bag_input.empty() != args.workflow_list_input.empty();
+
+    if(res.any_error() || (!args.daemon && !has_one_input)) {
         std::cout << "ERROR: Invalid command line arguments.\n"
             << make_man_page(cli, "static_task_scheduling");
         return std::nullopt;
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <io/command_line_arguments.hpp>
+#include <schedule/repair.hpp>
+#include <workflow/task_dependency.hpp>
+
+namespace io {
+
+// splits "a:b:c" into exactly num_fields numbers
+inline std::vector<double> parse_colon_separated_numbers(
+    std::string const & str,
+    size_t const num_fields,
+    std::string const & format
+) {
+    std::vector<double> numbers{};
+    std::stringstream stream(str);
+    std::string field{};
+
+    while (std::getline(stream, field, ':')) {
+        std::stringstream field_stream(field);
+        double number{};
+
+        if (!(field_stream >> number) || !field_stream.eof()) {
+            throw std::runtime_error("Invalid change '" + str + "', expected " + format + ".");
+        }
+
+        numbers.push_back(number);
+    }
+
+    if (numbers.size() != num_fields) {
+        throw std::runtime_error("Invalid change '" + str + "', expected " + format + ".");
+    }
+
+    return numbers;
+}
+
+inline size_t to_changed_task_id(double const number, size_t const num_tasks) {
+    if (number < 0 || number != static_cast<double>(static_cast<size_t>(number))) {
+        throw std::runtime_error("Task ids of changes must be non-negative integers.");
+    }
+
+    size_t const t_id = static_cast<size_t>(number);
+
+    if (t_id >= num_tasks) {
+        throw std::runtime_error("The task id of a change is not part of the workflow.");
+    }
+
+    return t_id;
+}
+
+// true if the computed schedules have to be repaired for changed inputs
+inline bool has_schedule_delta(command_line_arguments const & args) {
+    return args.fail_node || !args.workload_updates.empty() || !args.added_dependencies.empty();
+}
+
+// the changes of --fail-node, --update-workload and --add-dependency
+inline schedule::schedule_delta parse_schedule_delta(
+    command_line_arguments const & args,
+    size_t const num_tasks
+) {
+    schedule::schedule_delta delta{};
+
+    if (args.fail_node) {
+        delta.failed_node = args.failed_node_id;
+    }
+
+    for (std::string const & update : args.workload_updates) {
+        std::vector<double> const fields = parse_colon_separated_numbers(
+            update, 2, "<task_id>:<workload>"
+        );
+
+        if (fields[1] <= 0) {
+            throw std::runtime_error("All tasks need a workload > 0");
+        }
+
+        delta.workload_updates.push_back({to_changed_task_id(fields[0], num_tasks), fields[1]});
+    }
+
+    for (std::string const & added : args.added_dependencies) {
+        std::vector<double> const fields = parse_colon_separated_numbers(
+            added, 3, "<from_id>:<to_id>:<data_transfer>"
+        );
+
+        if (fields[2] < 0) {
+            throw std::runtime_error("The data transfer of an added dependency must not be negative.");
+        }
+
+        workflow::task_dependency const dep{
+            to_changed_task_id(fields[0], num_tasks),
+            to_changed_task_id(fields[1], num_tasks)
+        };
+        delta.added_dependencies.push_back({dep, fields[2]});
+    }
+
+    return delta;
+}
+
+} // namespace io
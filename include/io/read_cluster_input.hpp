@@ -0,0 +1,38 @@
+#pragma once
+
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <cluster/bandwidth_matrix.hpp>
+#include <cluster/cluster.hpp>
+#include <cluster/core_model.hpp>
+#include <io/read_csv.hpp>
+
+namespace io {
+
+// the link bandwidths are given by at most one of the racks file and the links file
+inline cluster::cluster read_cluster_input(
+    std::string const & cluster_input,
+    std::string const & rack_input,
+    std::string const & link_input,
+    std::optional<cluster::core_model> const cores
+) {
+    if (!rack_input.empty() && !link_input.empty()) {
+        throw std::runtime_error("A racks file and a links file can't be given at the same time.");
+    }
+
+    auto cluster_nodes = io::read_cluster_csv(cluster_input);
+
+    std::optional<cluster::bandwidth_matrix> link_bandwidths{};
+    if (!rack_input.empty()) {
+        link_bandwidths = io::read_rack_csv(rack_input, cluster_nodes.size());
+    } else if (!link_input.empty()) {
+        link_bandwidths = io::read_link_csv(link_input, cluster_nodes);
+    }
+
+    return cluster::cluster(std::move(cluster_nodes), std::move(link_bandwidths), cores);
+}
+
+} // namespace io
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <filesystem>
 #include <iostream>
 #include <numeric>
 #include <stdexcept>
@@ -11,6 +12,7 @@
 #define CSV_IO_NO_THREAD 
 #include <csv.h>
 
+#include <cluster/bandwidth_matrix.hpp>
 #include <cluster/cluster.hpp>
 #include <workflow/task_bag.hpp>
 #include <workflow/task_dependency.hpp>
@@ -26,7 +28,7 @@ using MyCSVReader = CSVReader<
     single_and_empty_line_comment<'#'>
 >;
 
-std::vector<cluster::cluster_node> read_cluster_csv(std::string const & filename) {
+inline std::vector<cluster::cluster_node> read_cluster_csv(std::string const & filename) {
     std::vector<cluster::cluster_node> nodes;
     MyCSVReader<4> in(filename);
 
@@ -44,19 +46,51 @@ std::vector<cluster::cluster_node> read_cluster_csv(std::string const & filename
         throw std::runtime_error("Cluster must have at least 1 node.");
     }
 
-    double const common_bandwidth = nodes.front().network_bandwidth;
+    return nodes;
+}
 
-    for (cluster::cluster_node const & node : nodes) {
-        if (node.network_bandwidth != common_bandwidth) {
-            std::cout << "WARNING: Not all cluster nodes have the same bandwidth\n";
-            break;
-        }
+inline cluster::bandwidth_matrix read_rack_csv(std::string const & filename, size_t const num_nodes) {
+    std::vector<cluster::rack> racks;
+    MyCSVReader<4> in(filename);
+
+    in.read_header(
+        ignore_no_column, 
+        "first_node_id", 
+        "last_node_id", 
+        "intra_rack_bandwidth", 
+        "inter_rack_bandwidth"
+    );
+
+    cluster::node_id first_node_id, last_node_id;
+    double intra_rack_bandwidth, inter_rack_bandwidth;
+
+    while (in.read_row(first_node_id, last_node_id, intra_rack_bandwidth, inter_rack_bandwidth)) {
+        racks.push_back({first_node_id, last_node_id, intra_rack_bandwidth, inter_rack_bandwidth});
     }
 
-    return nodes;
+    return cluster::bandwidth_matrix::from_racks(num_nodes, racks);
 }
 
-std::vector<workflow::task_bag> read_task_bag_csv(std::string const & filename) {
+inline cluster::bandwidth_matrix read_link_csv(
+    std::string const & filename, 
+    std::vector<cluster::cluster_node> const & nodes
+) {
+    std::vector<cluster::link> links;
+    MyCSVReader<3> in(filename);
+
+    in.read_header(ignore_no_column, "from_id", "to_id", "bandwidth");
+
+    cluster::node_id from_id, to_id;
+    double bandwidth;
+
+    while (in.read_row(from_id, to_id, bandwidth)) {
+        links.push_back({from_id, to_id, bandwidth});
+    }
+
+    return cluster::bandwidth_matrix::from_links(nodes, links);
+}
+
+inline std::vector<workflow::task_bag> read_task_bag_csv(std::string const & filename) {
     std::vector<workflow::task_bag> task_bags;
     MyCSVReader<5> in(filename);
 
@@ -75,7 +109,7 @@ std::vector<workflow::task_bag> read_task_bag_csv(std::string const & filename)
     return task_bags;
 }
 
-std::vector<workflow::task_dependency> read_dependency_csv(std::string const & filename) {
+inline std::vector<workflow::task_dependency> read_dependency_csv(std::string const & filename) {
     std::vector<workflow::task_dependency> dependencies;
     MyCSVReader<2> in(filename);
 
@@ -90,7 +124,7 @@ std::vector<workflow::task_dependency> read_dependency_csv(std::string const & f
     return dependencies;
 }
 
-std::vector<cluster::node_id> read_task_to_node_assignment_csv(
+inline std::vector<cluster::node_id> read_task_to_node_assignment_csv(
     std::string const & filename, 
     size_t const num_tasks,
     size_t const num_nodes
@@ -143,4 +177,42 @@ std::vector<cluster::node_id> read_task_to_node_assignment_csv(
     return task_to_node_assignment;
 }
 
+struct workflow_list_entry {
+    std::string task_bag_input;
+    std::string topology;
+    std::string dependency_input;
+    double release_time;
+    double priority;
+};
+
+// relative file names are relative to the directory of the list file
+inline std::vector<workflow_list_entry> read_workflow_list_csv(std::string const & filename) {
+    std::vector<workflow_list_entry> entries;
+    MyCSVReader<5> in(filename);
+
+    in.read_header(ignore_no_column, "task_bags", "topology", "dependencies", "release_time", "priority");
+
+    std::filesystem::path const directory = std::filesystem::path(filename).parent_path();
+    auto const resolve = [&directory] (std::string const & file) {
+        return file.empty() ? file : (directory / file).string();
+    };
+
+    std::string task_bag_input, topology, dependency_input;
+    double release_time, priority;
+
+    while (in.read_row(task_bag_input, topology, dependency_input, release_time, priority)) {
+        if (release_time < 0.0) {
+            throw std::runtime_error("Release times of workflows can't be negative.");
+        }
+
+        entries.push_back({resolve(task_bag_input), topology, resolve(dependency_input), release_time, priority});
+    }
+
+    if (entries.empty()) {
+        throw std::runtime_error("The workflow list must contain at least 1 workflow.");
+    }
+
+    return entries;
+}
+
 } // namespace io
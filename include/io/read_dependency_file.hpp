@@ -11,7 +11,7 @@
 
 namespace io {
 
-std::vector<workflow::task_dependency> read_dependency_file(std::string const & filename) {
+inline std::vector<workflow::task_dependency> read_dependency_file(std::string const & filename) {
     std::filesystem::path const dependency_path(filename);
 
     if (dependency_path.extension() == ".csv") {
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <io/read_csv.hpp>
+#include <io/read_dependency_file.hpp>
+#include <util/trace.hpp>
+#include <workflow/expand_task_bags.hpp>
+#include <workflow/task.hpp>
+#include <workflow/task_bag.hpp>
+#include <workflow/task_dependency.hpp>
+#include <workflow/topology/infer_dependencies.hpp>
+#include <workflow/topology/remove_bag_dependencies.hpp>
+#include <workflow/topology/topology.hpp>
+
+namespace io {
+
+// everything that is needed to construct a workflow
+struct workflow_input {
+    std::vector<workflow::task> tasks;
+    std::vector<double> input_data_sizes;
+    std::vector<double> output_data_sizes;
+    std::vector<workflow::task_dependency> dependencies;
+    std::vector<std::vector<workflow::task_id>> task_ids_per_bag;
+};
+
+// the dependencies are inferred from the topology if no dependency file is given
+inline workflow_input read_workflow_input(
+    std::string const & task_bag_input,
+    std::string const & topology_str,
+    std::string const & dependency_input
+) {
+    TRACE_SPAN("input", "read workflow input");
+
+    auto const task_bags = io::read_task_bag_csv(task_bag_input);
+    auto [tasks, input_data_sizes, output_data_sizes] = workflow::expand_task_bags(task_bags);
+    auto task_ids_per_bag = workflow::expand_task_bags_into_ids(task_bags);
+
+    workflow::topology::topology const top = workflow::topology::from_string(topology_str);
+    std::vector<workflow::task_dependency> dependencies =
+        dependency_input.empty() ?
+            workflow::topology::infer_dependencies(top, task_bags, task_ids_per_bag)
+            : io::read_dependency_file(dependency_input);
+
+    if (top == workflow::topology::topology::montage) {
+        // remove specific edges from the workflow which our model can't handle
+        workflow::topology::remove_bag_dependencies(dependencies, 0, 4, task_bags);
+    }
+
+    return {
+        std::move(tasks),
+        std::move(input_data_sizes),
+        std::move(output_data_sizes),
+        std::move(dependencies),
+        std::move(task_ids_per_bag)
+    };
+}
+
+} // namespace io
@@ -10,7 +10,7 @@
 
 namespace io {
 
-std::vector<workflow::task_dependency> read_workflow_xml(std::string const & filename) {
+inline std::vector<workflow::task_dependency> read_workflow_xml(std::string const & filename) {
     pugi::xml_document doc;
 
     pugi::xml_parse_result result = doc.load_file(filename.c_str());
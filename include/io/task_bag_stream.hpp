@@ -0,0 +1,165 @@
+#pragma once
+
+#include <array>
+#include <istream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include <workflow/task_bag.hpp>
+#include <workflow/task_dependency.hpp>
+
+namespace io {
+
+// a bag or a line "dependency, <from_id>, <to_id>" between two tasks, the task ids are 0-based
+// over all bags in the order of their arrival
+using task_bag_stream_entry = std::variant<workflow::task_bag, workflow::task_dependency>;
+
+// reads task bags one line at a time in the same format as read_task_bag_csv, in contrast to
+// the csv reader it doesn't read ahead, so every bag is available as soon as its line arrives
+// (e.g. from a pipe), dependency lines may appear between the bags
+class task_bag_stream {
+    static constexpr size_t num_columns = 5;
+    static constexpr std::array<std::string_view, num_columns> column_names = {
+        "workload", "input_data_size", "output_data_size", "memory", "cardinality"
+    };
+
+    std::istream & in;
+    // column index in the file -> index in column_names
+    std::array<size_t, num_columns> column_order{};
+    workflow::task_bag_id next_id{0};
+
+public:
+    explicit task_bag_stream(std::istream & in_) : in{in_} {
+        std::optional<std::string> const header = next_line();
+        if (!header) {
+            throw std::runtime_error("The task bag stream doesn't contain a header.");
+        }
+
+        std::array<bool, num_columns> seen{};
+        size_t column = 0;
+
+        for (std::string_view field : split(header.value())) {
+            size_t name_index = 0;
+            while (name_index < num_columns && column_names[name_index] != field) {
+                ++name_index;
+            }
+
+            if (column >= num_columns || name_index == num_columns || seen[name_index]) {
+                throw std::runtime_error("The task bag stream header has an unexpected column.");
+            }
+
+            seen[name_index] = true;
+            column_order[column++] = name_index;
+        }
+
+        if (column != num_columns) {
+            throw std::runtime_error("The task bag stream header misses a column.");
+        }
+    }
+
+    // blocks until the next bag or dependency arrives, std::nullopt at the end of the stream
+    std::optional<task_bag_stream_entry> next() {
+        std::optional<std::string> const line = next_line();
+        if (!line) {
+            return std::nullopt;
+        }
+
+        std::vector<std::string_view> const line_fields = split(line.value());
+
+        if (line_fields.front() == "dependency") {
+            if (line_fields.size() != 3) {
+                throw std::runtime_error("A dependency line of the task bag stream needs exactly two task ids.");
+            }
+
+            return workflow::task_dependency{
+                parse<workflow::task_id>(line_fields[1]),
+                parse<workflow::task_id>(line_fields[2])
+            };
+        }
+
+        std::array<std::string_view, num_columns> fields{};
+        size_t column = 0;
+
+        for (std::string_view field : line_fields) {
+            if (column >= num_columns) {
+                throw std::runtime_error("A line of the task bag stream has too many columns.");
+            }
+
+            fields[column_order[column++]] = field;
+        }
+
+        if (column != num_columns) {
+            throw std::runtime_error("A line of the task bag stream has too few columns.");
+        }
+
+        return workflow::task_bag{
+            next_id++,
+            parse<double>(fields[0]),
+            parse<double>(fields[1]),
+            parse<double>(fields[2]),
+            parse<double>(fields[3]),
+            parse<size_t>(fields[4])
+        };
+    }
+
+private:
+    // skips empty lines and comments starting with '#' as the csv reader does
+    std::optional<std::string> next_line() {
+        std::string line;
+
+        while (std::getline(in, line)) {
+            std::string_view const trimmed = trim(line);
+            if (!trimmed.empty() && trimmed.front() != '#') {
+                return std::string(trimmed);
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    static std::string_view trim(std::string_view s) {
+        // also handles files with windows line endings
+        size_t const first = s.find_first_not_of(" \t\r");
+        if (first == std::string_view::npos) {
+            return {};
+        }
+
+        size_t const last = s.find_last_not_of(" \t\r");
+        return s.substr(first, last - first + 1);
+    }
+
+    // trimmed fields separated by commas
+    static std::vector<std::string_view> split(std::string_view s) {
+        std::vector<std::string_view> fields{};
+
+        while (true) {
+            size_t const comma = s.find(',');
+            fields.push_back(trim(s.substr(0, comma)));
+
+            if (comma == std::string_view::npos) {
+                return fields;
+            }
+
+            s.remove_prefix(comma + 1);
+        }
+    }
+
+    template <typename T>
+    static T parse(std::string_view const field) {
+        std::istringstream field_in{std::string(field)};
+        T value{};
+
+        if (!(field_in >> value) || !field_in.eof()) {
+            throw std::runtime_error("The task bag stream contains an invalid number.");
+        }
+
+        return value;
+    }
+};
+
+} // namespace io
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace io {
+
+// owns a file descriptor of a socket and closes it on destruction
+class socket_fd {
+    int fd{-1};
+
+public:
+    explicit socket_fd(int const fd_) : fd{fd_} {}
+
+    socket_fd(socket_fd const &) = delete;
+    socket_fd & operator=(socket_fd const &) = delete;
+
+    socket_fd(socket_fd && other) : fd{other.fd} {
+        other.fd = -1;
+    }
+
+    ~socket_fd() {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    int get() const {
+        return fd;
+    }
+
+    // stops blocking reads of other threads on this connected socket
+    void shutdown_read() const {
+        ::shutdown(fd, SHUT_RD);
+    }
+};
+
+inline std::runtime_error socket_error(std::string const & what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+inline std::array<int, 2> create_socket_pair() {
+    std::array<int, 2> fds{};
+
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds.data()) < 0) {
+        throw socket_error("Could not create a socket pair");
+    }
+
+    return fds;
+}
+
+// a connected pair of sockets, the receiving end stays readable once wake was called, so a
+// thread that polls it wakes up on every platform, unlike shutting down a listening socket,
+// which only interrupts accept on Linux
+class wakeup_signal {
+    socket_fd receiving_end;
+    socket_fd sending_end;
+
+    explicit wakeup_signal(std::array<int, 2> const fds) : receiving_end(fds[0]), sending_end(fds[1]) {}
+
+public:
+    wakeup_signal() : wakeup_signal(create_socket_pair()) {}
+
+    void wake() const {
+        char const byte = 0;
+
+        while (::write(sending_end.get(), &byte, 1) < 0 && errno == EINTR) {}
+    }
+
+    int get() const {
+        return receiving_end.get();
+    }
+};
+
+// listens on a Unix domain socket at the given path, an existing socket file is replaced
+inline socket_fd listen_unix_socket(std::string const & path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("The socket path " + path + " is too long.");
+    }
+
+    path.copy(address.sun_path, path.size());
+
+    socket_fd listener(::socket(AF_UNIX, SOCK_STREAM, 0));
+    if (listener.get() < 0) {
+        throw socket_error("Could not create the socket " + path);
+    }
+
+    ::unlink(path.c_str());
+
+    if (::bind(listener.get(), reinterpret_cast<sockaddr const *>(&address), sizeof(address)) < 0) {
+        throw socket_error("Could not bind the socket " + path);
+    }
+
+    if (::listen(listener.get(), SOMAXCONN) < 0) {
+        throw socket_error("Could not listen on the socket " + path);
+    }
+
+    return listener;
+}
+
+// blocks until a client connects, std::nullopt as soon as the stop signal was woken
+inline std::optional<socket_fd> accept_connection(socket_fd const & listener, wakeup_signal const & stop) {
+    while (true) {
+        std::array<pollfd, 2> fds{{{listener.get(), POLLIN, 0}, {stop.get(), POLLIN, 0}}};
+
+        if (::poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            throw socket_error("Could not wait for a connection");
+        }
+
+        if (fds[1].revents != 0) {
+            return std::nullopt;
+        }
+
+        if (fds[0].revents == 0) {
+            continue;
+        }
+
+        int const fd = ::accept(listener.get(), nullptr, nullptr);
+
+        if (fd >= 0) {
+            return socket_fd(fd);
+        }
+
+        // the client may have given up between the poll and the accept
+        if (errno != EINTR && errno != ECONNABORTED) {
+            throw socket_error("Could not accept a connection");
+        }
+    }
+}
+
+// writes all bytes, returns false if the peer closed the connection
+inline bool write_all(socket_fd const & socket, std::string_view data) {
+    while (!data.empty()) {
+        ssize_t const written = ::send(socket.get(), data.data(), data.size(), MSG_NOSIGNAL);
+
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (written <= 0) {
+            return false;
+        }
+
+        data.remove_prefix(static_cast<size_t>(written));
+    }
+
+    return true;
+}
+
+// splits the bytes of a socket into lines without the line break
+class socket_line_reader {
+    socket_fd const & socket;
+    std::string buffer{};
+    size_t line_begin{0};
+
+public:
+    explicit socket_line_reader(socket_fd const & socket_) : socket{socket_} {}
+
+    // blocks until the next line arrives, std::nullopt if the peer closed the connection,
+    // a last line without a line break is returned as well
+    std::optional<std::string> next_line() {
+        while (true) {
+            size_t const line_end = buffer.find('\n', line_begin);
+
+            if (line_end != std::string::npos) {
+                std::string line = buffer.substr(line_begin, line_end - line_begin);
+                line_begin = line_end + 1;
+                return line;
+            }
+
+            buffer.erase(0, line_begin);
+            line_begin = 0;
+
+            char chunk[4096];
+            ssize_t const num_read = ::recv(socket.get(), chunk, sizeof(chunk), 0);
+
+            if (num_read < 0 && errno == EINTR) {
+                continue;
+            }
+
+            if (num_read <= 0) {
+                if (buffer.empty()) {
+                    return std::nullopt;
+                }
+
+                std::string line = std::move(buffer);
+                buffer.clear();
+                return line;
+            }
+
+            buffer.append(chunk, static_cast<size_t>(num_read));
+        }
+    }
+};
+
+} // namespace io
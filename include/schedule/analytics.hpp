@@ -0,0 +1,332 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <cluster/cluster.hpp>
+#include <cluster/cost_model.hpp>
+#include <schedule/node_schedule.hpp>
+#include <schedule/schedule.hpp>
+#include <schedule/time_interval.hpp>
+#include <util/epsilon_compare.hpp>
+#include <util/timepoint.hpp>
+#include <workflow/workflow.hpp>
+
+namespace schedule {
+
+// bucket k holds the idle gaps that are longer than makespan / 2^(k + 1) and at most
+// makespan / 2^k, the last bucket also holds all shorter gaps
+size_t constexpr num_idle_gap_buckets = 8;
+
+struct node_analytics {
+    // in the core model weighted by the share of the used cores
+    util::timepoint busy_time{0.0};
+    double utilization{0.0};
+    // the time until the makespan in which no task runs on the node
+    util::timepoint idle_time{0.0};
+    size_t num_idle_gaps{0};
+    util::timepoint longest_idle_gap{0.0};
+};
+
+struct schedule_analytics {
+    util::timepoint makespan{0.0};
+    std::vector<node_analytics> nodes{};
+    std::array<size_t, num_idle_gap_buckets> idle_gap_histogram{};
+
+    // the edges whose data is sent between two different nodes
+    size_t num_remote_edges{0};
+    double communication_volume{0.0};
+    util::timepoint communication_time{0.0};
+
+    // latest start minus actual start of the first interval of every task, the latest start keeps
+    // the makespan, the nodes of all intervals and their order on every node
+    std::vector<util::timepoint> task_slacks{};
+    size_t num_critical_tasks{0};
+
+    double mean_utilization() const {
+        if (nodes.empty()) {
+            return 0.0;
+        }
+
+        return std::transform_reduce(nodes.begin(), nodes.end(), 0.0, std::plus<>{},
+            [] (node_analytics const & node_a) {
+                return node_a.utilization;
+            }
+        ) / static_cast<double>(nodes.size());
+    }
+
+    // ties are broken by the lower node id
+    std::vector<cluster::node_id> node_ids_by_utilization_descending() const {
+        std::vector<cluster::node_id> node_ids(nodes.size());
+        std::iota(node_ids.begin(), node_ids.end(), 0);
+
+        std::ranges::stable_sort(node_ids, std::greater<>{}, [this] (cluster::node_id const n_id) {
+            return nodes[n_id].utilization;
+        });
+
+        return node_ids;
+    }
+
+    // a few lines with the busiest nodes instead of all nodes
+    std::string to_string(std::string const & algo) const {
+        size_t constexpr num_listed_nodes = 5;
+
+        std::stringstream out{};
+        out << std::fixed << std::setprecision(2);
+        out << algo << " analytics -- makespan " << makespan << '\n';
+
+        out << "utilization: mean " << mean_utilization() * 100.0 << " %, busiest nodes";
+        std::vector<cluster::node_id> const node_ids = node_ids_by_utilization_descending();
+        for (size_t i = 0; i < std::min(num_listed_nodes, node_ids.size()); ++i) {
+            out << (i == 0 ? " " : ", ") << node_ids[i] << " (" << nodes[node_ids[i]].utilization * 100.0 << " %)";
+        }
+        if (!node_ids.empty()) {
+            out << ", least busy node " << node_ids.back()
+                << " (" << nodes[node_ids.back()].utilization * 100.0 << " %)";
+        }
+        out << '\n';
+
+        size_t num_idle_gaps = 0;
+        util::timepoint idle_time = 0.0;
+        for (node_analytics const & node_a : nodes) {
+            num_idle_gaps += node_a.num_idle_gaps;
+            idle_time += node_a.idle_time;
+        }
+
+        out << "idle gaps: " << num_idle_gaps << " with " << idle_time << " idle time in total, "
+            << "by share of the makespan:";
+        for (size_t k = 0; k < num_idle_gap_buckets; ++k) {
+            size_t const denominator = size_t{1} << k;
+            out << (k == 0 ? " " : ", ");
+
+            if (k + 1 == num_idle_gap_buckets) {
+                out << "<= 1/" << denominator;
+            } else {
+                out << "> 1/" << 2 * denominator;
+            }
+
+            out << ": " << idle_gap_histogram[k];
+        }
+        out << '\n';
+
+        out << "communication: " << num_remote_edges << " edges between nodes, volume "
+            << communication_volume << ", transfer time " << communication_time << '\n';
+
+        util::timepoint const max_slack = task_slacks.empty() ? 0.0 : std::ranges::max(task_slacks);
+        util::timepoint const mean_slack = task_slacks.empty() ? 0.0
+            : std::reduce(task_slacks.begin(), task_slacks.end()) / static_cast<double>(task_slacks.size());
+
+        out << "slack: " << num_critical_tasks << " of " << task_slacks.size()
+            << " tasks critical (no slack), mean " << mean_slack << ", max " << max_slack << '\n';
+
+        return out.str();
+    }
+
+    // a single line with all nodes and the slack of every task
+    std::string to_json(std::string const & algo) const {
+        std::stringstream out{};
+        out << std::setprecision(10);
+
+        out << "{\"algorithm\":\"" << algo << "\",\"makespan\":" << makespan
+            << ",\"mean_utilization\":" << mean_utilization() << ",\"nodes\":[";
+
+        for (cluster::node_id n_id = 0; n_id < nodes.size(); ++n_id) {
+            node_analytics const & node_a = nodes[n_id];
+            out << (n_id == 0 ? "" : ",") << "{\"id\":" << n_id
+                << ",\"busy_time\":" << node_a.busy_time
+                << ",\"utilization\":" << node_a.utilization
+                << ",\"idle_time\":" << node_a.idle_time
+                << ",\"idle_gaps\":" << node_a.num_idle_gaps
+                << ",\"longest_idle_gap\":" << node_a.longest_idle_gap << '}';
+        }
+
+        out << "],\"idle_gap_histogram\":[";
+        for (size_t k = 0; k < num_idle_gap_buckets; ++k) {
+            out << (k == 0 ? "" : ",") << idle_gap_histogram[k];
+        }
+
+        out << "],\"remote_edges\":" << num_remote_edges
+            << ",\"communication_volume\":" << communication_volume
+            << ",\"communication_time\":" << communication_time
+            << ",\"critical_tasks\":" << num_critical_tasks
+            << ",\"task_slacks\":[";
+
+        for (size_t t_id = 0; t_id < task_slacks.size(); ++t_id) {
+            out << (t_id == 0 ? "" : ",") << task_slacks[t_id];
+        }
+
+        out << "]}";
+
+        return out.str();
+    }
+};
+
+// Running time analysis:
+// O(|V| + |E| * d + |I|) for the intervals I and at most d intervals per task (duplicates)
+
+// the latest starts are computed backwards from the makespan over the constraints between the
+// intervals, the data of an edge must arrive in time and a task that uses the whole node must end
+// before the next interval on its node starts, the intervals are processed as soon as all their
+// successors are done (Kahn's algorithm), so no sorting is needed
+template <cluster::cost_model M>
+schedule_analytics analyze(schedule<M> const & s, workflow::workflow const & w) {
+    schedule_analytics a{};
+    a.makespan = s.get_makespan();
+
+    auto const add_idle_gap = [&a] (node_analytics & node_a, util::timepoint const gap) {
+        node_a.idle_time += gap;
+        ++node_a.num_idle_gaps;
+        node_a.longest_idle_gap = std::max(node_a.longest_idle_gap, gap);
+
+        size_t k = 0;
+        while (k + 1 < num_idle_gap_buckets && gap * static_cast<double>(size_t{2} << k) <= a.makespan) {
+            ++k;
+        }
+
+        ++a.idle_gap_histogram[k];
+    };
+
+    // all intervals are numbered node by node in the order of the node schedules,
+    // which is also the order of for_each_interval
+    std::vector<time_interval const *> intervals{};
+    std::unordered_map<scheduled_task_id, size_t> index_of{};
+
+    for (node_schedule const & node_s : s.get_node_schedules()) {
+        node_analytics & node_a = a.nodes.emplace_back();
+        double const num_cores = static_cast<double>(node_s.get_node().num_cores);
+        // in the core model the intervals of a node can overlap
+        util::timepoint covered_until = 0.0;
+
+        for (time_interval const & interval : node_s.get_intervals()) {
+            index_of.emplace(interval.task_id, intervals.size());
+            intervals.push_back(&interval);
+
+            double const core_share = interval.cores == 0 ? 1.0 : static_cast<double>(interval.cores) / num_cores;
+            node_a.busy_time += (interval.end - interval.start) * core_share;
+
+            if (util::epsilon_less(covered_until, interval.start)) {
+                add_idle_gap(node_a, interval.start - covered_until);
+            }
+
+            covered_until = std::max(covered_until, interval.end);
+        }
+
+        if (util::epsilon_less(covered_until, a.makespan)) {
+            add_idle_gap(node_a, a.makespan - covered_until);
+        }
+
+        node_a.utilization = a.makespan == 0.0 ? 0.0 : node_a.busy_time / a.makespan;
+    }
+
+    size_t const num_intervals = intervals.size();
+
+    // the predecessor constraints of interval j are preds[pred_offsets[j], pred_offsets[j + 1])
+    struct constraint {
+        size_t pred_index;
+        util::timepoint lag;
+    };
+
+    std::vector<size_t> pred_offsets(num_intervals + 1, 0);
+    std::vector<constraint> preds{};
+    std::vector<size_t> num_successors(num_intervals, 0);
+
+    s.for_each_data_edge(w, [&] (
+        [[maybe_unused]] workflow::task_id const pred_t_id,
+        time_interval const & pred_interval,
+        [[maybe_unused]] workflow::task_id const t_id,
+        time_interval const & interval,
+        double const data_transfer,
+        util::timepoint const data_transfer_cost
+    ) {
+        size_t const i = index_of.at(pred_interval.task_id);
+        size_t const j = index_of.at(interval.task_id);
+
+        ++pred_offsets[j + 1];
+        preds.push_back({i, data_transfer_cost});
+        ++num_successors[i];
+
+        if (pred_interval.node_id != interval.node_id) {
+            ++a.num_remote_edges;
+            a.communication_volume += data_transfer;
+            a.communication_time += data_transfer_cost;
+        }
+    });
+
+    // the edges are visited in the order of the intervals
+    std::partial_sum(pred_offsets.begin(), pred_offsets.end(), pred_offsets.begin());
+
+    // whole node intervals never overlap with the next interval on their node
+    std::vector<bool> has_node_successor(num_intervals, false);
+    for (size_t g = 0; g + 1 < num_intervals; ++g) {
+        if (
+            intervals[g]->node_id == intervals[g + 1]->node_id
+            && intervals[g]->cores == 0 && intervals[g + 1]->cores == 0
+        ) {
+            has_node_successor[g] = true;
+            ++num_successors[g];
+        }
+    }
+
+    std::vector<util::timepoint> latest_finish(num_intervals, a.makespan);
+    // intervals that are never processed only exist in invalid schedules and have no slack
+    std::vector<util::timepoint> latest_start(num_intervals);
+    std::vector<size_t> ready{};
+
+    for (size_t g = 0; g < num_intervals; ++g) {
+        latest_start[g] = intervals[g]->start;
+
+        if (num_successors[g] == 0) {
+            ready.push_back(g);
+        }
+    }
+
+    while (!ready.empty()) {
+        size_t const j = ready.back();
+        ready.pop_back();
+
+        latest_start[j] = latest_finish[j] - (intervals[j]->end - intervals[j]->start);
+
+        auto const relax = [&] (size_t const i, util::timepoint const lag) {
+            latest_finish[i] = std::min(latest_finish[i], latest_start[j] - lag);
+
+            if (--num_successors[i] == 0) {
+                ready.push_back(i);
+            }
+        };
+
+        for (size_t k = pred_offsets[j]; k < pred_offsets[j + 1]; ++k) {
+            relax(preds[k].pred_index, preds[k].lag);
+        }
+
+        if (j > 0 && has_node_successor[j - 1]) {
+            relax(j - 1, 0.0);
+        }
+    }
+
+    a.task_slacks.assign(w.size(), 0.0);
+
+    for (workflow::task_id t_id = 0; t_id < w.size(); ++t_id) {
+        if (!s.is_scheduled(t_id)) {
+            continue;
+        }
+
+        size_t const g = index_of.at(s.get_task_intervals(t_id).front().task_id);
+        a.task_slacks[t_id] = std::max(latest_start[g] - intervals[g]->start, 0.0);
+
+        if (util::epsilon_eq(a.task_slacks[t_id], 0.0)) {
+            ++a.num_critical_tasks;
+        }
+    }
+
+    return a;
+}
+
+} // namespace schedule
@@ -0,0 +1,260 @@
+#pragma once
+
+#include <algorithm>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <cluster/cluster.hpp>
+#include <cluster/cluster_node.hpp>
+#include <cluster/cost_model.hpp>
+#include <util/timepoint.hpp>
+#include <workflow/flat_edges.hpp>
+#include <workflow/workflow.hpp>
+
+namespace schedule {
+
+// evaluates task to node assignments with the same insertion policy as from_assignment and
+// exactly the same floating point operations, so the makespans are bit-identical, the tasks can
+// also be inserted in any other topological order than the one of their ids
+
+// everything that doesn't depend on the assignment is precomputed once, the node timelines are
+// segments of one flat buffer that is reused for every call, so an evaluation doesn't allocate,
+// the search for a large enough gap skips whole blocks of intervals via their maximum gap
+template <cluster::cost_model M>
+class assignment_decoder {
+    static constexpr size_t gap_block_size = 32;
+
+    M model;
+    size_t num_tasks;
+    size_t num_nodes;
+
+    workflow::flat_edges incoming_edges;
+    std::vector<double> workloads;
+
+    // from_assignment inserts the tasks in the order of their ids
+    std::vector<workflow::task_id> id_order;
+    bool id_order_is_topological{true};
+
+    // the intervals of node n are at [segment_offsets[n], segment_offsets[n] + segment_sizes[n])
+    // sorted by time, every segment has room for all tasks that are assigned to the node
+    std::vector<size_t> segment_offsets;
+    std::vector<size_t> segment_sizes;
+    std::vector<util::timepoint> interval_starts;
+    std::vector<util::timepoint> interval_ends;
+
+    // interval_gaps[i] is the idle time between the intervals i and i + 1 of a segment,
+    // the maximum gap of every block of gap_block_size gaps is stored per segment from block_offsets[n]
+    std::vector<util::timepoint> interval_gaps;
+    std::vector<size_t> block_offsets;
+    std::vector<util::timepoint> block_max_gaps;
+
+    std::vector<util::timepoint> finish_times;
+
+public:
+    assignment_decoder(cluster::cluster const & c, workflow::workflow const & w)
+        : model(c), num_tasks(w.size()), num_nodes(c.size()),
+          incoming_edges(workflow::flatten_incoming_edges(w)),
+          workloads(w.size()),
+          id_order(w.size()),
+          segment_offsets(c.size() + 1),
+          segment_sizes(c.size()),
+          interval_starts(w.size()),
+          interval_ends(w.size()),
+          interval_gaps(w.size()),
+          block_offsets(c.size() + 1),
+          block_max_gaps(w.size() / gap_block_size + c.size()),
+          finish_times(w.size()) {
+        std::iota(id_order.begin(), id_order.end(), 0);
+
+        for (workflow::task_id t_id = 0; t_id < num_tasks; ++t_id) {
+            workloads[t_id] = w.get_task(t_id).workload;
+
+            for (size_t i = incoming_edges.begin(t_id); i < incoming_edges.end(t_id); ++i) {
+                if (incoming_edges.neighbor_ids[i] > t_id) {
+                    id_order_is_topological = false;
+                }
+            }
+        }
+    }
+
+    util::timepoint makespan(std::span<cluster::node_id const> const assignment) {
+        return makespan(assignment, {});
+    }
+
+    // start_times is only filled if it is not empty, it must have one entry per task then
+    util::timepoint makespan(
+        std::span<cluster::node_id const> const assignment,
+        std::span<util::timepoint> const start_times
+    ) {
+        if (!id_order_is_topological) {
+            throw std::invalid_argument(
+                "Assignments can only be decoded in id order if the task ids are a topological order."
+            );
+        }
+
+        return makespan(assignment, id_order, start_times);
+    }
+
+    // the tasks are inserted in the given order, which must contain every task exactly once
+    // and every task after all of its predecessors
+    util::timepoint makespan(
+        std::span<cluster::node_id const> const assignment,
+        std::span<workflow::task_id const> const insertion_order,
+        std::span<util::timepoint> const start_times
+    ) {
+        if (assignment.size() != num_tasks || (!start_times.empty() && start_times.size() != num_tasks)) {
+            throw std::invalid_argument("The assignment must contain exactly one node per task.");
+        }
+
+        if (insertion_order.size() != num_tasks) {
+            throw std::invalid_argument("The insertion order must contain every task exactly once.");
+        }
+
+        prepare_segments(assignment);
+
+        for (workflow::task_id const t_id : insertion_order) {
+            cluster::node_id const n_id = assignment[t_id];
+
+            // same as the ready time of schedule, the maximum doesn't depend on the edge order
+            util::timepoint ready_time = 0.0;
+            for (size_t i = incoming_edges.begin(t_id); i < incoming_edges.end(t_id); ++i) {
+                workflow::task_id const pred_id = incoming_edges.neighbor_ids[i];
+                ready_time = std::max(
+                    ready_time,
+                    finish_times[pred_id] + model.data_transfer_cost(
+                        incoming_edges.data_transfers[i], assignment[pred_id], n_id
+                    )
+                );
+            }
+
+            util::timepoint const computation_time = model.computation_time(workloads[t_id], n_id);
+            util::timepoint const eft = insert_into_segment(n_id, ready_time, computation_time);
+            finish_times[t_id] = eft;
+
+            if (!start_times.empty()) {
+                start_times[t_id] = eft - computation_time;
+            }
+        }
+
+        util::timepoint result = 0.0;
+        for (cluster::node_id n_id = 0; n_id < num_nodes; ++n_id) {
+            if (segment_sizes[n_id] > 0) {
+                result = std::max(result, interval_ends[segment_offsets[n_id] + segment_sizes[n_id] - 1]);
+            }
+        }
+
+        return result;
+    }
+
+private:
+    void prepare_segments(std::span<cluster::node_id const> const assignment) {
+        std::ranges::fill(segment_sizes, 0);
+
+        for (cluster::node_id const n_id : assignment) {
+            if (n_id >= num_nodes) {
+                throw std::invalid_argument("The assignment contains an invalid node id.");
+            }
+
+            ++segment_sizes[n_id];
+        }
+
+        for (cluster::node_id n_id = 0; n_id < num_nodes; ++n_id) {
+            size_t const num_blocks = (segment_sizes[n_id] + gap_block_size - 1) / gap_block_size;
+            segment_offsets[n_id + 1] = segment_offsets[n_id] + segment_sizes[n_id];
+            block_offsets[n_id + 1] = block_offsets[n_id] + num_blocks;
+            segment_sizes[n_id] = 0;
+        }
+    }
+
+    // the same slot search as node_schedule::compute_earliest_finish_time, returns the EFT
+    util::timepoint insert_into_segment(
+        cluster::node_id const n_id,
+        util::timepoint const ready_time,
+        util::timepoint const computation_time
+    ) {
+        util::timepoint * const starts = interval_starts.data() + segment_offsets[n_id];
+        util::timepoint * const ends = interval_ends.data() + segment_offsets[n_id];
+        size_t const size = segment_sizes[n_id];
+
+        size_t position = static_cast<size_t>(std::lower_bound(ends, ends + size, ready_time) - ends);
+        util::timepoint eft{};
+
+        if (position == size) {
+            util::timepoint const earliest_start_time = size == 0 ? ready_time : std::max(ends[size - 1], ready_time);
+            eft = earliest_start_time + computation_time;
+        } else if (position == 0 && starts[0] >= ready_time + computation_time) {
+            eft = ready_time + computation_time;
+        } else {
+            position = first_fitting_gap(n_id, position, computation_time);
+            eft = ends[position] + computation_time;
+            ++position;
+        }
+
+        std::copy_backward(starts + position, starts + size, starts + size + 1);
+        std::copy_backward(ends + position, ends + size, ends + size + 1);
+        starts[position] = eft - computation_time;
+        ends[position] = eft;
+        ++segment_sizes[n_id];
+
+        update_gaps(n_id, position);
+
+        return eft;
+    }
+
+    // first interval from position on that is followed by a gap of at least the computation time
+    // or the last interval, the gaps are computed exactly as in node_schedule
+    size_t first_fitting_gap(
+        cluster::node_id const n_id,
+        size_t position,
+        util::timepoint const computation_time
+    ) const {
+        util::timepoint const * const gaps = interval_gaps.data() + segment_offsets[n_id];
+        util::timepoint const * const max_gaps = block_max_gaps.data() + block_offsets[n_id];
+        size_t const last = segment_sizes[n_id] - 1;
+
+        while (position < last) {
+            if (position % gap_block_size == 0 && max_gaps[position / gap_block_size] < computation_time) {
+                position = std::min(position + gap_block_size, last);
+                continue;
+            }
+
+            if (gaps[position] >= computation_time) {
+                return position;
+            }
+
+            ++position;
+        }
+
+        return last;
+    }
+
+    // recomputes all gaps and block maxima that changed by an insertion at the given position
+    void update_gaps(cluster::node_id const n_id, size_t const inserted_position) {
+        size_t const size = segment_sizes[n_id];
+        if (size < 2) {
+            return;
+        }
+
+        util::timepoint const * const starts = interval_starts.data() + segment_offsets[n_id];
+        util::timepoint const * const ends = interval_ends.data() + segment_offsets[n_id];
+        util::timepoint * const gaps = interval_gaps.data() + segment_offsets[n_id];
+        util::timepoint * const max_gaps = block_max_gaps.data() + block_offsets[n_id];
+
+        size_t const first_gap = inserted_position == 0 ? 0 : inserted_position - 1;
+        size_t const last_gap = size - 2;
+
+        for (size_t i = first_gap; i <= last_gap; ++i) {
+            gaps[i] = starts[i + 1] - ends[i];
+        }
+
+        for (size_t block = first_gap / gap_block_size; block <= last_gap / gap_block_size; ++block) {
+            size_t const block_begin = block * gap_block_size;
+            size_t const block_end = std::min(block_begin + gap_block_size, last_gap + 1);
+            max_gaps[block] = *std::max_element(gaps + block_begin, gaps + block_end);
+        }
+    }
+};
+
+} // namespace schedule
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <util/timepoint.hpp>
+
+namespace schedule {
+
+// number of busy cores of one node over time as a step function, a slot search only needs the
+// steps after the ready time, so it doesn't depend on the number of cores of the node
+class core_timeline {
+    struct step {
+        util::timepoint time;
+        // busy cores from this time until the time of the next step
+        size_t busy_cores;
+    };
+
+    // sorted by time, no core is busy before the first step and from the last step on
+    std::vector<step> steps{};
+    size_t num_cores;
+
+public:
+    explicit core_timeline(size_t const num_cores_) : num_cores{num_cores_} {}
+
+    // earliest start time from the ready time on at which the given number of cores is free
+    // for the whole duration
+    util::timepoint earliest_start_time(
+        util::timepoint const ready_time,
+        util::timepoint const duration,
+        size_t const cores
+    ) const {
+        if (cores > num_cores) {
+            throw std::runtime_error("Internal bug: a task requests more cores than its node has.");
+        }
+
+        util::timepoint start = ready_time;
+
+        // the last step that starts before or at the ready time, its segment contains the ready time
+        auto const it = std::ranges::upper_bound(steps, ready_time, {}, &step::time);
+        size_t i = it == steps.begin() ? 0 : static_cast<size_t>(it - steps.begin()) - 1;
+
+        for (; i < steps.size() && steps[i].time < start + duration; ++i) {
+            if (steps[i].busy_cores + cores > num_cores) {
+                // the last step has no busy cores, so there is always a next step
+                start = steps[i + 1].time;
+            }
+        }
+
+        return start;
+    }
+
+    void clear() {
+        steps.clear();
+    }
+
+    void add(util::timepoint const start, util::timepoint const end, size_t const cores) {
+        size_t const first = split(start);
+        size_t const last = split(end);
+
+        for (size_t i = first; i < last; ++i) {
+            steps[i].busy_cores += cores;
+        }
+
+        merge(last);
+        merge(first);
+    }
+
+    void remove(util::timepoint const start, util::timepoint const end, size_t const cores) {
+        size_t const first = split(start);
+        size_t const last = split(end);
+
+        for (size_t i = first; i < last; ++i) {
+            if (steps[i].busy_cores < cores) {
+                throw std::runtime_error("Internal bug: more cores are released than were used.");
+            }
+
+            steps[i].busy_cores -= cores;
+        }
+
+        merge(last);
+        merge(first);
+    }
+
+    // end of the last busy segment
+    util::timepoint busy_until() const {
+        return steps.empty() ? 0.0 : steps.back().time;
+    }
+
+private:
+    // index of the step at the given time, which is inserted if it doesn't exist yet
+    size_t split(util::timepoint const time) {
+        auto const it = std::ranges::lower_bound(steps, time, {}, &step::time);
+        size_t const index = static_cast<size_t>(it - steps.begin());
+
+        if (it == steps.end() || it->time != time) {
+            size_t const busy_cores = index == 0 ? 0 : steps[index - 1].busy_cores;
+            steps.insert(it, step{time, busy_cores});
+        }
+
+        return index;
+    }
+
+    // removes the step at the given index if it doesn't change the number of busy cores
+    void merge(size_t const index) {
+        if (index >= steps.size()) {
+            return;
+        }
+
+        size_t const busy_cores_before = index == 0 ? 0 : steps[index - 1].busy_cores;
+        if (steps[index].busy_cores == busy_cores_before) {
+            steps.erase(steps.begin() + static_cast<std::ptrdiff_t>(index));
+        }
+    }
+};
+
+} // namespace schedule
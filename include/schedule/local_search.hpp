@@ -0,0 +1,850 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <cluster/cluster.hpp>
+#include <cluster/cost_model.hpp>
+#include <schedule/schedule.hpp>
+#include <util/timepoint.hpp>
+#include <workflow/flat_edges.hpp>
+#include <workflow/workflow.hpp>
+
+namespace schedule {
+
+// a limit of 0 means no limit, nothing is done if both limits are 0
+struct local_search_budget {
+    size_t time_ms{0};
+    size_t max_iterations{0};
+    std::uint64_t seed{1};
+};
+
+struct local_search_statistics {
+    size_t num_evaluations{0};
+    size_t num_accepted_moves{0};
+};
+
+// improves a schedule with task migration and task swap moves between nodes
+
+// the solution is an assignment of tasks to nodes together with a fixed key order of the tasks,
+// derived from the start times of the given schedule, every node executes its tasks in key order
+// as early as possible, a move only reevaluates the tasks that might start at a different time
+// (the downstream cone of the moved tasks), in key order with a bitmap of dirty key ranks
+
+// moves that don't increase the makespan and don't increase the sum of all finish times are
+// accepted, the evaluation of a move is aborted as soon as a task finishes later than the makespan
+// minus its tail time, i.e. the longest path of computation and data transfer times from its end
+// to the end of the schedule over its successors and the later tasks on its node
+// a move doesn't change the tail times of the tasks after the moved tasks in key order, so most
+// rejected moves are aborted at the first task, the tail times of the earlier tasks are only
+// updated (backwards in key order) after a move was accepted, a move is also rejected as soon as
+// no remaining task can finish earlier and the finish time sum already increased
+template <cluster::cost_model M>
+class local_search {
+    cluster::cluster const & c;
+    workflow::workflow const & w;
+    bool use_memory_requirements;
+    M model;
+
+    size_t num_tasks;
+    size_t num_nodes;
+
+    workflow::flat_edges incoming_edges;
+    workflow::flat_edges outgoing_edges;
+
+    // row-major (#tasks x #nodes) matrices
+    std::vector<util::timepoint> computation_times{};
+    std::vector<bool> fits_into_memory{};
+
+    // lower bound for the time between the end of a task and the end of all its descendants,
+    // the longest path over the smallest computation times without any data transfer, only used
+    // for the tasks between the two tasks of a swap whose old tail times might be too long
+    std::vector<util::timepoint> min_tail_times{};
+
+    // key_order[key_ranks[t]] == t, predecessors always have a lower key rank
+    std::vector<workflow::task_id> key_order{};
+    std::vector<size_t> key_ranks{};
+
+    // current solution, every node sequence is sorted by key rank, the neighbors of a task in
+    // its node sequence are workflow::no_task at both ends
+    std::vector<cluster::node_id> node_of_task{};
+    std::vector<std::vector<workflow::task_id>> node_sequences{};
+    std::vector<workflow::task_id> previous_in_sequence{};
+    std::vector<workflow::task_id> next_in_sequence{};
+    std::vector<util::timepoint> finish_times{};
+    std::vector<util::timepoint> tail_times{};
+    util::timepoint makespan{0.0};
+
+    // the latest arrival of the input data of a task and the longest path after a task over its
+    // successors only, both are maxima over all edges of the task that are updated edge by edge,
+    // the edges are only rescanned if the maximum edge got shorter or the task was moved
+    std::vector<util::timepoint> data_ready_times{};
+    std::vector<util::timepoint> successor_tail_times{};
+
+    // scratch space of the evaluation that is reused for every move
+    // bit r is set if the task with key rank r has to be reevaluated, all bits are
+    // cleared after every move, only the words in [first, last] can be non-zero
+    std::vector<std::uint64_t> dirty_words{};
+    size_t num_dirty{0};
+    size_t first_dirty_word{0};
+    size_t last_dirty_word{0};
+
+    // tasks whose edges are rescanned when they are reevaluated next
+    std::vector<bool> needs_rescan{};
+    std::vector<workflow::task_id> rescan_requests{};
+
+    struct time_change {
+        workflow::task_id t_id;
+        util::timepoint old_time;
+    };
+
+    std::vector<time_change> finish_time_changes{};
+    std::vector<time_change> data_ready_time_changes{};
+
+    struct migration {
+        workflow::task_id t_id;
+        cluster::node_id from_n_id;
+    };
+
+    std::vector<migration> applied_migrations{};
+
+    // the tail times of all tasks with a higher key rank are still valid during an evaluation,
+    // the tail time of the moved task with this key rank is recomputed before the evaluation
+    size_t max_moved_key_rank{0};
+    util::timepoint old_moved_tail_time{0.0};
+    util::timepoint old_moved_path_length{0.0};
+
+public:
+    local_search(
+        schedule<M> const & s,
+        cluster::cluster const & c_,
+        workflow::workflow const & w_,
+        bool const use_memory_requirements_
+    ) : c(c_), w(w_), use_memory_requirements(use_memory_requirements_), model(c_),
+        num_tasks(w_.size()), num_nodes(c_.size()),
+        incoming_edges(workflow::flatten_incoming_edges(w_)),
+        outgoing_edges(workflow::flatten_outgoing_edges(w_)) {
+        if (!s.is_complete(w)) {
+            throw std::invalid_argument("Only complete schedules can be improved.");
+        }
+
+        compute_task_node_matrices();
+        compute_min_tail_times();
+
+        // duplicates are dropped, every task stays on the node of its first interval
+        node_of_task = s.get_task_assignment(w);
+        key_order = s.get_task_start_order(w);
+
+        key_ranks.resize(num_tasks);
+        for (size_t r = 0; r < num_tasks; ++r) {
+            key_ranks[key_order[r]] = r;
+        }
+
+        node_sequences.resize(num_nodes);
+        previous_in_sequence.assign(num_tasks, workflow::no_task);
+        next_in_sequence.assign(num_tasks, workflow::no_task);
+        for (workflow::task_id const t_id : key_order) {
+            auto & sequence = node_sequences[node_of_task[t_id]];
+
+            if (!sequence.empty()) {
+                previous_in_sequence[t_id] = sequence.back();
+                next_in_sequence[sequence.back()] = t_id;
+            }
+
+            sequence.push_back(t_id);
+        }
+
+        data_ready_times.resize(num_tasks);
+        finish_times.resize(num_tasks);
+        for (workflow::task_id const t_id : key_order) {
+            data_ready_times[t_id] = compute_data_ready_time(t_id);
+            finish_times[t_id] = compute_finish_time(t_id);
+        }
+
+        successor_tail_times.resize(num_tasks);
+        tail_times.resize(num_tasks);
+        for (auto it = key_order.rbegin(); it != key_order.rend(); ++it) {
+            successor_tail_times[*it] = compute_successor_tail_time(*it);
+            tail_times[*it] = compute_tail_time(*it);
+        }
+
+        makespan = compute_makespan();
+
+        dirty_words.assign((num_tasks + 63) / 64, 0);
+        needs_rescan.assign(num_tasks, false);
+        finish_time_changes.reserve(num_tasks);
+        data_ready_time_changes.reserve(num_tasks);
+    }
+
+    local_search_statistics run(local_search_budget const & budget) {
+        local_search_statistics stats{};
+
+        if ((budget.time_ms == 0 && budget.max_iterations == 0) || num_nodes < 2 || num_tasks == 0) {
+            return stats;
+        }
+
+        auto const deadline = std::chrono::steady_clock::now()
+            + std::chrono::milliseconds(budget.time_ms);
+
+        std::mt19937_64 rng(budget.seed);
+        std::uniform_int_distribution<workflow::task_id> task_dist(0, num_tasks - 1);
+        std::uniform_int_distribution<cluster::node_id> node_dist(0, num_nodes - 1);
+        std::bernoulli_distribution swap_dist(0.5);
+
+        // swap partners are close in key order, a swap of far apart tasks hardly differs from two
+        // migrations but reevaluates all tasks between them
+        size_t constexpr max_swap_distance = 64;
+        std::uniform_int_distribution<size_t> swap_offset_dist(0, 2 * max_swap_distance);
+
+        // the clock is only read every few iterations
+        size_t constexpr iterations_per_clock_check = 64;
+
+        for (size_t iteration = 0; ; ++iteration) {
+            if (budget.max_iterations != 0 && iteration >= budget.max_iterations) {
+                break;
+            }
+
+            if (
+                budget.time_ms != 0
+                && iteration % iterations_per_clock_check == 0
+                && std::chrono::steady_clock::now() >= deadline
+            ) {
+                break;
+            }
+
+            workflow::task_id const t_id = task_dist(rng);
+            cluster::node_id const t_n_id = node_of_task[t_id];
+
+            begin_move();
+
+            if (swap_dist(rng)) {
+                size_t const shifted_rank = key_ranks[t_id] + swap_offset_dist(rng);
+
+                if (shifted_rank < max_swap_distance || shifted_rank - max_swap_distance >= num_tasks) {
+                    continue;
+                }
+
+                workflow::task_id const other_t_id = key_order[shifted_rank - max_swap_distance];
+                cluster::node_id const other_n_id = node_of_task[other_t_id];
+
+                if (
+                    t_n_id == other_n_id
+                    || !fits(t_id, other_n_id)
+                    || !fits(other_t_id, t_n_id)
+                ) {
+                    continue;
+                }
+
+                migrate(t_id, other_n_id);
+                migrate(other_t_id, t_n_id);
+            } else {
+                cluster::node_id const to_n_id = node_dist(rng);
+
+                if (to_n_id == t_n_id || !fits(t_id, to_n_id)) {
+                    continue;
+                }
+
+                migrate(t_id, to_n_id);
+            }
+
+            ++stats.num_evaluations;
+
+            if (evaluate_move()) {
+                ++stats.num_accepted_moves;
+            } else {
+                revert_move();
+            }
+        }
+
+        return stats;
+    }
+
+    util::timepoint get_makespan() const {
+        return makespan;
+    }
+
+    // node of every task in the current solution
+    std::vector<cluster::node_id> const & get_assignment() const {
+        return node_of_task;
+    }
+
+    // the order in which every node executes its tasks, it never changes
+    std::vector<workflow::task_id> const & get_key_order() const {
+        return key_order;
+    }
+
+    // the tasks are inserted in key order, so no task finishes later than in the solution
+    schedule<M> to_schedule() const {
+        schedule<M> s(c, use_memory_requirements);
+
+        for (workflow::task_id const t_id : key_order) {
+            s.insert_into_node_schedule(t_id, node_of_task[t_id], w);
+        }
+
+        return s;
+    }
+
+private:
+    void compute_task_node_matrices() {
+        computation_times.resize(num_tasks * num_nodes);
+        fits_into_memory.resize(num_tasks * num_nodes);
+
+        for (workflow::task_id t_id = 0; t_id < num_tasks; ++t_id) {
+            workflow::task const & t = w.get_task(t_id);
+            for (cluster::cluster_node const & node : c) {
+                computation_times[t_id * num_nodes + node.id] = model.computation_time(t.workload, node.id);
+                fits_into_memory[t_id * num_nodes + node.id] = !use_memory_requirements
+                    || node.memory >= t.memory_requirement;
+            }
+        }
+    }
+
+    void compute_min_tail_times() {
+        min_tail_times.assign(num_tasks, 0.0);
+        auto const & topological_order = w.get_task_topological_order();
+
+        for (auto it = topological_order.rbegin(); it != topological_order.rend(); ++it) {
+            workflow::task_id const t_id = *it;
+
+            for (size_t i = outgoing_edges.begin(t_id); i < outgoing_edges.end(t_id); ++i) {
+                workflow::task_id const succ_id = outgoing_edges.neighbor_ids[i];
+                util::timepoint const * const succ_row = computation_times.data() + succ_id * num_nodes;
+                util::timepoint const min_computation_time = *std::min_element(succ_row, succ_row + num_nodes);
+
+                min_tail_times[t_id] = std::max(
+                    min_tail_times[t_id],
+                    min_computation_time + min_tail_times[succ_id]
+                );
+            }
+        }
+    }
+
+    bool fits(workflow::task_id const t_id, cluster::node_id const n_id) const {
+        return fits_into_memory[t_id * num_nodes + n_id];
+    }
+
+    // position of the first task in the sequence of the node with a key rank that is not lower
+    size_t sequence_position(workflow::task_id const t_id, cluster::node_id const n_id) const {
+        auto const & sequence = node_sequences[n_id];
+        auto const it = std::ranges::lower_bound(sequence, key_ranks[t_id], {},
+            [this] (workflow::task_id const other_t_id) {
+                return key_ranks[other_t_id];
+            }
+        );
+
+        return static_cast<size_t>(it - sequence.begin());
+    }
+
+    util::timepoint computation_time(workflow::task_id const t_id, cluster::node_id const n_id) const {
+        return computation_times[t_id * num_nodes + n_id];
+    }
+
+    util::timepoint compute_data_ready_time(workflow::task_id const t_id) const {
+        cluster::node_id const n_id = node_of_task[t_id];
+        util::timepoint ready_time = 0.0;
+
+        for (size_t i = incoming_edges.begin(t_id); i < incoming_edges.end(t_id); ++i) {
+            workflow::task_id const pred_id = incoming_edges.neighbor_ids[i];
+            ready_time = std::max(
+                ready_time,
+                finish_times[pred_id] + model.data_transfer_cost(
+                    incoming_edges.data_transfers[i], node_of_task[pred_id], n_id
+                )
+            );
+        }
+
+        return ready_time;
+    }
+
+    util::timepoint compute_finish_time(workflow::task_id const t_id) const {
+        util::timepoint ready_time = data_ready_times[t_id];
+
+        workflow::task_id const previous_t_id = previous_in_sequence[t_id];
+        if (previous_t_id != workflow::no_task) {
+            ready_time = std::max(ready_time, finish_times[previous_t_id]);
+        }
+
+        return ready_time + computation_time(t_id, node_of_task[t_id]);
+    }
+
+    // the length of the path after the task over the given outgoing edge
+    util::timepoint successor_path_length(
+        workflow::task_id const t_id,
+        size_t const outgoing_edge,
+        util::timepoint const succ_tail_time
+    ) const {
+        workflow::task_id const succ_id = outgoing_edges.neighbor_ids[outgoing_edge];
+        cluster::node_id const succ_n_id = node_of_task[succ_id];
+
+        return model.data_transfer_cost(outgoing_edges.data_transfers[outgoing_edge], node_of_task[t_id], succ_n_id)
+            + computation_time(succ_id, succ_n_id) + succ_tail_time;
+    }
+
+    // only reads the tail times of tasks with a higher key rank, during an evaluation only lower
+    // bounds of these are known (before any of them was reevaluated)
+    util::timepoint compute_successor_tail_time(
+        workflow::task_id const t_id,
+        bool const during_evaluation = false
+    ) const {
+        util::timepoint tail_time = 0.0;
+
+        for (size_t i = outgoing_edges.begin(t_id); i < outgoing_edges.end(t_id); ++i) {
+            workflow::task_id const succ_id = outgoing_edges.neighbor_ids[i];
+            util::timepoint const succ_tail_time = during_evaluation
+                ? tail_time_lower_bound(succ_id, finish_times[succ_id])
+                : tail_times[succ_id];
+            tail_time = std::max(tail_time, successor_path_length(t_id, i, succ_tail_time));
+        }
+
+        return tail_time;
+    }
+
+    util::timepoint compute_tail_time(workflow::task_id const t_id, bool const during_evaluation = false) const {
+        util::timepoint tail_time = during_evaluation
+            ? compute_successor_tail_time(t_id, true)
+            : successor_tail_times[t_id];
+
+        workflow::task_id const next_t_id = next_in_sequence[t_id];
+        if (next_t_id != workflow::no_task) {
+            util::timepoint const next_tail_time = during_evaluation
+                ? tail_time_lower_bound(next_t_id, finish_times[next_t_id])
+                : tail_times[next_t_id];
+            tail_time = std::max(tail_time, computation_time(next_t_id, node_of_task[t_id]) + next_tail_time);
+        }
+
+        return tail_time;
+    }
+
+    // the tail times of the tasks after the last moved task are unchanged during an evaluation,
+    // for an earlier task (after all other moved tasks) every path that doesn't contain the last
+    // moved task is still part of the solution and at least as long as before, the paths over
+    // the last moved task were at most as long as its old finish plus tail time minus the old
+    // finish time of the task, so the old tail time is a lower bound if it is longer than that
+    util::timepoint tail_time_lower_bound(
+        workflow::task_id const t_id,
+        util::timepoint const old_finish_time
+    ) const {
+        if (
+            key_ranks[t_id] >= max_moved_key_rank
+            || old_finish_time + tail_times[t_id] > old_moved_path_length
+        ) {
+            return tail_times[t_id];
+        }
+
+        return min_tail_times[t_id];
+    }
+
+    // the node of the task before the current move
+    cluster::node_id former_node(workflow::task_id const t_id) const {
+        if (key_ranks[t_id] <= max_moved_key_rank) {
+            for (migration const & applied : applied_migrations) {
+                if (applied.t_id == t_id) {
+                    return applied.from_n_id;
+                }
+            }
+        }
+
+        return node_of_task[t_id];
+    }
+
+    util::timepoint compute_makespan() const {
+        util::timepoint result = 0.0;
+
+        // the finish times along a node sequence are monotone
+        for (auto const & sequence : node_sequences) {
+            if (!sequence.empty()) {
+                result = std::max(result, finish_times[sequence.back()]);
+            }
+        }
+
+        return result;
+    }
+
+    void begin_move() {
+        finish_time_changes.clear();
+        data_ready_time_changes.clear();
+        applied_migrations.clear();
+        num_dirty = 0;
+        first_dirty_word = dirty_words.size();
+        last_dirty_word = 0;
+        max_moved_key_rank = 0;
+    }
+
+    void mark_dirty(workflow::task_id const t_id) {
+        if (t_id == workflow::no_task) {
+            return;
+        }
+
+        size_t const rank = key_ranks[t_id];
+        size_t const word = rank / 64;
+        std::uint64_t const bit = std::uint64_t{1} << (rank % 64);
+
+        if (dirty_words[word] & bit) {
+            return;
+        }
+
+        dirty_words[word] |= bit;
+        ++num_dirty;
+        first_dirty_word = std::min(first_dirty_word, word);
+        last_dirty_word = std::max(last_dirty_word, word);
+    }
+
+    // the data ready time of the task is recomputed from all its incoming edges when it is
+    // evaluated instead of being updated edge by edge, every task is requested at most once
+    void request_rescan(workflow::task_id const t_id) {
+        if (!needs_rescan[t_id]) {
+            needs_rescan[t_id] = true;
+            rescan_requests.push_back(t_id);
+        }
+    }
+
+    void clear_rescan_requests() {
+        for (workflow::task_id const t_id : rescan_requests) {
+            needs_rescan[t_id] = false;
+        }
+
+        rescan_requests.clear();
+    }
+
+    // moves the task and marks all tasks dirty whose inputs changed
+    void migrate(workflow::task_id const t_id, cluster::node_id const to_n_id) {
+        cluster::node_id const from_n_id = node_of_task[t_id];
+        workflow::task_id const former_next_t_id = move_in_sequences(t_id, to_n_id);
+        applied_migrations.push_back({t_id, from_n_id});
+        max_moved_key_rank = std::max(max_moved_key_rank, key_ranks[t_id]);
+
+        // the former successor on the old node now follows the former predecessor
+        mark_dirty(former_next_t_id);
+        mark_dirty(next_in_sequence[t_id]);
+        mark_dirty(t_id);
+        request_rescan(t_id);
+
+        // the data transfer costs to all successors changed
+        for (size_t i = outgoing_edges.begin(t_id); i < outgoing_edges.end(t_id); ++i) {
+            mark_dirty(outgoing_edges.neighbor_ids[i]);
+        }
+    }
+
+    workflow::task_id move_in_sequences(workflow::task_id const t_id, cluster::node_id const to_n_id) {
+        auto & from_sequence = node_sequences[node_of_task[t_id]];
+        from_sequence.erase(from_sequence.begin() + sequence_position(t_id, node_of_task[t_id]));
+
+        workflow::task_id const former_previous_t_id = previous_in_sequence[t_id];
+        workflow::task_id const former_next_t_id = next_in_sequence[t_id];
+        if (former_previous_t_id != workflow::no_task) {
+            next_in_sequence[former_previous_t_id] = former_next_t_id;
+        }
+        if (former_next_t_id != workflow::no_task) {
+            previous_in_sequence[former_next_t_id] = former_previous_t_id;
+        }
+
+        auto & to_sequence = node_sequences[to_n_id];
+        size_t const to_position = sequence_position(t_id, to_n_id);
+        workflow::task_id const previous_t_id = to_position == 0 ? workflow::no_task : to_sequence[to_position - 1];
+        workflow::task_id const next_t_id = to_position == to_sequence.size() ? workflow::no_task : to_sequence[to_position];
+        to_sequence.insert(to_sequence.begin() + to_position, t_id);
+
+        previous_in_sequence[t_id] = previous_t_id;
+        next_in_sequence[t_id] = next_t_id;
+        if (previous_t_id != workflow::no_task) {
+            next_in_sequence[previous_t_id] = t_id;
+        }
+        if (next_t_id != workflow::no_task) {
+            previous_in_sequence[next_t_id] = t_id;
+        }
+
+        node_of_task[t_id] = to_n_id;
+
+        return former_next_t_id;
+    }
+
+    void clear_dirty_words(size_t const first_word) {
+        if (first_word <= last_dirty_word) {
+            std::fill(dirty_words.begin() + first_word, dirty_words.begin() + last_dirty_word + 1, 0);
+        }
+
+        num_dirty = 0;
+    }
+
+    // the old data ready time is recorded, so it can be restored if the move is rejected
+    void set_data_ready_time(workflow::task_id const t_id, util::timepoint const ready_time) {
+        if (ready_time != data_ready_times[t_id]) {
+            data_ready_time_changes.push_back({t_id, data_ready_times[t_id]});
+            data_ready_times[t_id] = ready_time;
+        }
+    }
+
+    // the finish time or the node of the predecessor over the outgoing edge changed, moved tasks
+    // themselves are always rescanned
+    void update_data_ready_time(
+        workflow::task_id const pred_id,
+        cluster::node_id const old_pred_n_id,
+        util::timepoint const old_pred_finish_time,
+        size_t const outgoing_edge
+    ) {
+        workflow::task_id const t_id = outgoing_edges.neighbor_ids[outgoing_edge];
+
+        if (needs_rescan[t_id]) {
+            return;
+        }
+
+        double const data_transfer = outgoing_edges.data_transfers[outgoing_edge];
+        cluster::node_id const n_id = node_of_task[t_id];
+        util::timepoint const arrival_time = finish_times[pred_id]
+            + model.data_transfer_cost(data_transfer, node_of_task[pred_id], n_id);
+        util::timepoint const old_arrival_time = old_pred_finish_time
+            + model.data_transfer_cost(data_transfer, old_pred_n_id, n_id);
+
+        if (arrival_time > data_ready_times[t_id]) {
+            set_data_ready_time(t_id, arrival_time);
+        } else if (arrival_time < old_arrival_time && old_arrival_time == data_ready_times[t_id]) {
+            request_rescan(t_id);
+        }
+    }
+
+    // propagates the dirty tasks in key order, returns whether the move is accepted
+    bool evaluate_move() {
+        workflow::task_id const last_moved_t_id = key_order[max_moved_key_rank];
+        old_moved_tail_time = tail_times[last_moved_t_id];
+        old_moved_path_length = finish_times[last_moved_t_id] + old_moved_tail_time;
+        tail_times[last_moved_t_id] = compute_tail_time(last_moved_t_id, true);
+
+        double finish_time_sum_delta = 0.0;
+
+        // only the initially dirty tasks and the successors of tasks that finish earlier can finish
+        // earlier, after them the finish time sum and the makespan can't decrease anymore
+        size_t last_decreasing_rank = last_dirty_word * 64 + 63
+            - static_cast<size_t>(std::countl_zero(dirty_words[last_dirty_word]));
+        bool makespan_might_decrease = false;
+
+        // all tasks that become dirty have a higher key rank, so a single forward scan suffices
+        size_t word = first_dirty_word;
+
+        while (num_dirty > 0) {
+            std::uint64_t const bits = dirty_words[word];
+
+            if (bits == 0) {
+                ++word;
+                continue;
+            }
+
+            // clear the lowest set bit
+            dirty_words[word] = bits & (bits - 1);
+            --num_dirty;
+
+            size_t const rank = word * 64 + static_cast<size_t>(std::countr_zero(bits));
+
+            if (rank > last_decreasing_rank && finish_time_sum_delta > 0.0 && !makespan_might_decrease) {
+                clear_dirty_words(word);
+                return false;
+            }
+
+            workflow::task_id const t_id = key_order[rank];
+
+            if (needs_rescan[t_id]) {
+                needs_rescan[t_id] = false;
+                set_data_ready_time(t_id, compute_data_ready_time(t_id));
+            }
+
+            util::timepoint const finish_time = compute_finish_time(t_id);
+            util::timepoint const old_finish_time = finish_times[t_id];
+
+            // the tail time of a moved task can grow even if it finishes at the same time
+            cluster::node_id const old_n_id = former_node(t_id);
+            bool const moved = old_n_id != node_of_task[t_id];
+
+            if (finish_time == old_finish_time && !moved) {
+                continue;
+            }
+
+            if (finish_time != old_finish_time) {
+                finish_time_changes.push_back({t_id, old_finish_time});
+                finish_times[t_id] = finish_time;
+                finish_time_sum_delta += finish_time - old_finish_time;
+            }
+
+            util::timepoint const tail_time = rank < max_moved_key_rank && moved
+                ? compute_tail_time(t_id, true)
+                : tail_time_lower_bound(t_id, old_finish_time);
+
+            if ((finish_time > old_finish_time || moved) && finish_time + tail_time > makespan) {
+                clear_dirty_words(word);
+                return false;
+            }
+
+            bool const decreased = finish_time < old_finish_time;
+            makespan_might_decrease = makespan_might_decrease || (decreased && old_finish_time == makespan);
+
+            for (size_t i = outgoing_edges.begin(t_id); i < outgoing_edges.end(t_id); ++i) {
+                workflow::task_id const succ_id = outgoing_edges.neighbor_ids[i];
+                mark_dirty(succ_id);
+                update_data_ready_time(t_id, old_n_id, old_finish_time, i);
+
+                if (decreased) {
+                    last_decreasing_rank = std::max(last_decreasing_rank, key_ranks[succ_id]);
+                }
+            }
+
+            workflow::task_id const next_t_id = next_in_sequence[t_id];
+            mark_dirty(next_t_id);
+
+            if (decreased && next_t_id != workflow::no_task) {
+                last_decreasing_rank = std::max(last_decreasing_rank, key_ranks[next_t_id]);
+            }
+        }
+
+        util::timepoint const new_makespan = compute_makespan();
+
+        if (new_makespan < makespan || finish_time_sum_delta <= 0.0) {
+            makespan = new_makespan;
+            update_tail_times();
+            return true;
+        }
+
+        return false;
+    }
+
+    // the tail time or the node of the successor over the incoming edge changed, moved tasks
+    // themselves are always rescanned
+    void update_successor_tail_time(
+        workflow::task_id const succ_id,
+        cluster::node_id const old_succ_n_id,
+        util::timepoint const old_succ_tail_time,
+        size_t const incoming_edge
+    ) {
+        workflow::task_id const t_id = incoming_edges.neighbor_ids[incoming_edge];
+
+        if (needs_rescan[t_id]) {
+            return;
+        }
+
+        double const data_transfer = incoming_edges.data_transfers[incoming_edge];
+        cluster::node_id const n_id = node_of_task[t_id];
+        cluster::node_id const succ_n_id = node_of_task[succ_id];
+        util::timepoint const path_length = model.data_transfer_cost(data_transfer, n_id, succ_n_id)
+            + computation_time(succ_id, succ_n_id) + tail_times[succ_id];
+        util::timepoint const old_path_length = model.data_transfer_cost(data_transfer, n_id, old_succ_n_id)
+            + computation_time(succ_id, old_succ_n_id) + old_succ_tail_time;
+
+        if (path_length > successor_tail_times[t_id]) {
+            successor_tail_times[t_id] = path_length;
+        } else if (path_length < old_path_length && old_path_length == successor_tail_times[t_id]) {
+            request_rescan(t_id);
+        }
+    }
+
+    // recomputes the tail times of the tasks whose paths to the end of the schedule changed,
+    // backwards in key order with the same bitmap (which is empty after every evaluation)
+    void update_tail_times() {
+        clear_rescan_requests();
+        first_dirty_word = dirty_words.size();
+        last_dirty_word = 0;
+
+        // the exact tail time of the last moved task was only needed for the evaluation
+        tail_times[key_order[max_moved_key_rank]] = old_moved_tail_time;
+
+        for (migration const & applied : applied_migrations) {
+            workflow::task_id const t_id = applied.t_id;
+
+            // the tasks that preceded or now precede the moved task on a node and its predecessors
+            mark_dirty(t_id);
+            request_rescan(t_id);
+            mark_dirty(previous_in_sequence[t_id]);
+
+            size_t const former_position = sequence_position(t_id, applied.from_n_id);
+            if (former_position > 0) {
+                mark_dirty(node_sequences[applied.from_n_id][former_position - 1]);
+            }
+
+            for (size_t i = incoming_edges.begin(t_id); i < incoming_edges.end(t_id); ++i) {
+                mark_dirty(incoming_edges.neighbor_ids[i]);
+            }
+        }
+
+        // all tasks that become dirty have a lower key rank, so a single backward scan suffices
+        size_t word = last_dirty_word;
+
+        while (num_dirty > 0) {
+            std::uint64_t const bits = dirty_words[word];
+
+            if (bits == 0) {
+                --word;
+                continue;
+            }
+
+            // clear the highest set bit
+            size_t const bit = 63 - static_cast<size_t>(std::countl_zero(bits));
+            dirty_words[word] = bits & ~(std::uint64_t{1} << bit);
+            --num_dirty;
+
+            workflow::task_id const t_id = key_order[word * 64 + bit];
+
+            if (needs_rescan[t_id]) {
+                needs_rescan[t_id] = false;
+                successor_tail_times[t_id] = compute_successor_tail_time(t_id);
+            }
+
+            util::timepoint const tail_time = compute_tail_time(t_id);
+            util::timepoint const old_tail_time = tail_times[t_id];
+            cluster::node_id const old_n_id = former_node(t_id);
+
+            // the paths over a moved task to its predecessors changed even if its tail time didn't
+            if (tail_time == old_tail_time && old_n_id == node_of_task[t_id]) {
+                continue;
+            }
+
+            tail_times[t_id] = tail_time;
+
+            for (size_t i = incoming_edges.begin(t_id); i < incoming_edges.end(t_id); ++i) {
+                mark_dirty(incoming_edges.neighbor_ids[i]);
+                update_successor_tail_time(t_id, old_n_id, old_tail_time, i);
+            }
+
+            mark_dirty(previous_in_sequence[t_id]);
+        }
+
+        rescan_requests.clear();
+    }
+
+    void revert_move() {
+        tail_times[key_order[max_moved_key_rank]] = old_moved_tail_time;
+        clear_rescan_requests();
+
+        for (auto it = finish_time_changes.rbegin(); it != finish_time_changes.rend(); ++it) {
+            finish_times[it->t_id] = it->old_time;
+        }
+
+        for (auto it = data_ready_time_changes.rbegin(); it != data_ready_time_changes.rend(); ++it) {
+            data_ready_times[it->t_id] = it->old_time;
+        }
+
+        for (auto it = applied_migrations.rbegin(); it != applied_migrations.rend(); ++it) {
+            move_in_sequences(it->t_id, it->from_n_id);
+        }
+    }
+};
+
+// runs the local search on the given schedule and returns the better of both schedules
+template <cluster::cost_model M>
+schedule<M> improve_by_local_search(
+    schedule<M> const & s,
+    cluster::cluster const & c,
+    workflow::workflow const & w,
+    bool const use_memory_requirements,
+    local_search_budget const & budget
+) {
+    local_search<M> search(s, c, w, use_memory_requirements);
+    search.run(budget);
+
+    schedule<M> improved = search.to_schedule();
+
+    return improved.get_makespan() < s.get_makespan() ? improved : s;
+}
+
+} // namespace schedule
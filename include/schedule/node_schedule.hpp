@@ -1,10 +1,15 @@
 #pragma once
 
 #include <algorithm>
+#include <optional>
 #include <sstream>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include <cluster/cluster_node.hpp>
+#include <cluster/core_model.hpp>
+#include <schedule/core_timeline.hpp>
 #include <schedule/time_interval.hpp>
 #include <util/epsilon_compare.hpp>
 #include <util/timepoint.hpp>
@@ -13,64 +18,107 @@
 
 namespace schedule {
 
+// the tasks of a node run one after another on the whole node, or in the core model
+// at the same time on disjoint subsets of its cores
 class node_schedule {
+    // sorted by start
     std::vector<time_interval> intervals{};
     cluster::cluster_node const & node;
+    // a disabled node (e.g. after a node failure) doesn't get any new tasks
+    bool disabled{false};
+
+    // only used in the core model
+    std::optional<cluster::core_model> cores{};
+    std::optional<core_timeline> busy_cores{};
 
 public:
     using iterator = std::vector<time_interval>::iterator;
 
     struct time_slot {
+        util::timepoint const start;
         util::timepoint const eft;
         iterator const it;
+        // 0 if the task uses the whole node
+        size_t const cores{0};
     };
 
-    node_schedule(cluster::cluster_node const & node_) :
-        node{node_} {}
+    node_schedule(
+        cluster::cluster_node const & node_,
+        std::optional<cluster::core_model> const cores_ = std::nullopt
+    ) : node{node_}, cores{cores_} {
+        if (cores) {
+            busy_cores.emplace(node.num_cores);
+        }
+    }
 
     node_schedule(node_schedule const & other) :
-        node{other.node} {
+        node{other.node}, disabled{other.disabled}, cores{other.cores} {
             intervals = other.intervals;
+            busy_cores = other.busy_cores;
         }
     
     node_schedule(node_schedule && other) :
-        node{other.node} {
+        node{other.node}, disabled{other.disabled}, cores{other.cores} {
             intervals = std::move(other.intervals);
+            busy_cores = std::move(other.busy_cores);
         }
 
     node_schedule & operator=(node_schedule const & other) {
         intervals = other.intervals;
+        disabled = other.disabled;
+        cores = other.cores;
+        busy_cores = other.busy_cores;
         // no change for the node reference needed
         return *this;
     }
 
     node_schedule & operator=(node_schedule && other) {
         intervals = std::move(other.intervals);
+        disabled = other.disabled;
+        cores = other.cores;
+        busy_cores = std::move(other.busy_cores);
         // no change for the node reference needed
         return *this;
     }
 
-    // returns EFT and iterator before which the task could be scheduled
+    // removes all intervals and enables the node again, the memory is kept for reuse
+    void clear() {
+        intervals.clear();
+        disabled = false;
+
+        if (busy_cores) {
+            busy_cores->clear();
+        }
+    }
+
+    // returns the slot with the lowest EFT for a task with the given computation time on the
+    // whole node and the iterator before which it could be scheduled
     time_slot compute_earliest_finish_time(
         util::timepoint const ready_time,
-        workflow::task const & t
+        util::timepoint const computation_time
     ) {
+        if (cores) {
+            return compute_earliest_finish_time_on_cores(ready_time, computation_time);
+        }
+
         auto ends_before = [] (time_interval const & interval, util::timepoint const & time) {
             return interval.end < time;
         };
+        // the start is derived from the EFT in the same way as in the assignment decoder
+        auto to_slot = [computation_time] (util::timepoint const eft, iterator const it) {
+            return time_slot{eft - computation_time, eft, it};
+        };
         auto curr_it = std::lower_bound(intervals.begin(), intervals.end(), ready_time, ends_before);
-        
-        util::timepoint const computation_time = get_computation_time(t);
 
         if (curr_it == intervals.end()) {
             // no insertion possible -> schedule task to end after ready time
             util::timepoint const earliest_start_time = intervals.empty() ? ready_time : std::max(intervals.back().end, ready_time);
-            return time_slot{earliest_start_time + computation_time, intervals.end()};
+            return to_slot(earliest_start_time + computation_time, intervals.end());
         }
 
         if (curr_it == intervals.begin() && curr_it->start >= ready_time + computation_time) {
             // insertion possible at ready time before any other task on this node
-            return time_slot{ready_time + computation_time, curr_it};
+            return to_slot(ready_time + computation_time, curr_it);
         }
 
         while (true) {
@@ -80,15 +128,53 @@ public:
                 next_it == intervals.end() || // no insertion possible -> schedule task to end
                 next_it->start - curr_it->end >= computation_time // insertion possible here
             ) {
-                return time_slot{curr_it->end + computation_time, next_it};
+                return to_slot(curr_it->end + computation_time, next_it);
             }
 
             curr_it = next_it;
         }
     }
 
-    void insert(iterator const & it, time_interval const interval) {
-        intervals.emplace(it, interval);
+    // returns the position of the inserted interval
+    size_t insert(iterator const & it, time_interval const interval) {
+        if (busy_cores) {
+            busy_cores->add(interval.start, interval.end, interval.cores);
+        }
+
+        auto const inserted_it = intervals.emplace(it, interval);
+        return static_cast<size_t>(inserted_it - intervals.begin());
+    }
+
+    void erase(size_t const position) {
+        if (busy_cores) {
+            time_interval const & interval = intervals.at(position);
+            busy_cores->remove(interval.start, interval.end, interval.cores);
+        }
+
+        intervals.erase(intervals.begin() + position);
+    }
+
+    // position of the interval of the given scheduled task, the intervals are sorted by start
+    size_t find(time_interval const interval) const {
+        auto it = std::ranges::lower_bound(intervals, interval.start, {}, &time_interval::start);
+
+        while (it != intervals.end() && it->task_id != interval.task_id) {
+            ++it;
+        }
+
+        if (it == intervals.end()) {
+            throw std::runtime_error("Internal bug: interval is not part of its node schedule.");
+        }
+
+        return static_cast<size_t>(it - intervals.begin());
+    }
+
+    void disable() {
+        disabled = true;
+    }
+
+    bool is_disabled() const {
+        return disabled;
     }
 
     bool is_valid() const {
@@ -96,6 +182,10 @@ public:
             return true;
         }
 
+        if (cores) {
+            return is_valid_on_cores();
+        }
+
         for (size_t i = 0; i < intervals.size(); ++i) {
             // interval itself must be consistent
             if (util::epsilon_greater(intervals[i].start, intervals[i].end)) {
@@ -118,11 +208,15 @@ public:
         return node;
     }
 
-    util::timepoint get_computation_time(workflow::task const & t) const {
-        return t.workload / node.performance();
+    std::vector<time_interval> const & get_intervals() const {
+        return intervals;
     }
 
     util::timepoint get_total_finish_time() const {
+        if (busy_cores) {
+            return busy_cores->busy_until();
+        }
+
         return intervals.empty() ? 0.0 : intervals.back().end;
     }
 
@@ -137,7 +231,7 @@ public:
     }
 
     std::string to_string(
-        std::unordered_map<scheduled_task_id, workflow::task_id> const & scheduled_to_original_task_id
+        std::vector<workflow::task_id> const & scheduled_to_original_task_id
     ) const {
         std::stringstream out;
 
@@ -145,11 +239,85 @@ public:
         for (time_interval const & interval : intervals) {
             workflow::task_id const original_t_id = scheduled_to_original_task_id.at(interval.task_id);
             out << " (" << original_t_id << ": " << interval.start
-                << " -> " << interval.end << ")";  
+                << " -> " << interval.end;
+
+            if (interval.cores != 0) {
+                out << " on " << interval.cores << (interval.cores == 1 ? " core" : " cores");
+            }
+
+            out << ")";
         }
 
         return out.str();
     }
+
+private:
+    // every number of cores up to the maximum is a power of two or the maximum itself, the
+    // time of a slot search only depends on the intervals after the ready time, so a node with
+    // 64 cores needs 7 searches, ties are broken by fewer cores
+    time_slot compute_earliest_finish_time_on_cores(
+        util::timepoint const ready_time,
+        util::timepoint const computation_time
+    ) {
+        // the computation time of the cost model uses the performance of all cores
+        util::timepoint const single_core_time = computation_time * static_cast<double>(node.num_cores);
+        size_t const max_cores = cores->max_cores(node);
+
+        std::optional<time_slot> best_slot{};
+        size_t num_cores = 1;
+
+        while (true) {
+            util::timepoint const duration = single_core_time * cores->amdahl_factor(num_cores);
+            util::timepoint const start = busy_cores->earliest_start_time(ready_time, duration, num_cores);
+
+            if (!best_slot || start + duration < best_slot->eft) {
+                best_slot.emplace(start, start + duration, intervals.end(), num_cores);
+            }
+
+            if (num_cores == max_cores) {
+                break;
+            }
+
+            num_cores = std::min(2 * num_cores, max_cores);
+        }
+
+        // keep the intervals sorted by start
+        auto const it = std::ranges::upper_bound(intervals, best_slot->start, {}, &time_interval::start);
+        return time_slot{best_slot->start, best_slot->eft, it, best_slot->cores};
+    }
+
+    // at no time more cores are used than the node has, the intervals are swept independently
+    // of the core timeline
+    bool is_valid_on_cores() const {
+        // (time, change of the busy cores), ends come before starts at the same time
+        std::vector<std::pair<util::timepoint, long>> events{};
+
+        for (time_interval const & interval : intervals) {
+            if (
+                util::epsilon_greater(interval.start, interval.end) 
+                || interval.cores == 0 
+                || interval.cores > node.num_cores
+            ) {
+                return false;
+            }
+
+            events.emplace_back(interval.start, static_cast<long>(interval.cores));
+            events.emplace_back(interval.end, -static_cast<long>(interval.cores));
+        }
+
+        std::ranges::sort(events);
+
+        long curr_busy_cores = 0;
+        for (auto const & [time, change] : events) {
+            curr_busy_cores += change;
+
+            if (curr_busy_cores > static_cast<long>(node.num_cores)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
 };
 
 } // namespace schedule
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include <cluster/cluster.hpp>
+#include <cluster/cost_model.hpp>
+#include <schedule/schedule.hpp>
+#include <schedule/time_interval.hpp>
+#include <util/timepoint.hpp>
+#include <workflow/task.hpp>
+#include <workflow/task_dependency.hpp>
+#include <workflow/workflow.hpp>
+
+namespace schedule {
+
+struct workload_update {
+    workflow::task_id t_id;
+    double workload;
+};
+
+struct added_dependency {
+    workflow::task_dependency dependency;
+    double data_transfer;
+};
+
+// changes of the inputs after a schedule was computed
+struct schedule_delta {
+    std::vector<workload_update> workload_updates{};
+    std::optional<cluster::node_id> failed_node{};
+    std::vector<added_dependency> added_dependencies{};
+};
+
+// the failed node only affects the schedule
+inline void apply_delta(workflow::workflow & w, schedule_delta const & delta) {
+    for (workload_update const & update : delta.workload_updates) {
+        w.update_task_workload(update.t_id, update.workload);
+    }
+
+    for (added_dependency const & added : delta.added_dependencies) {
+        w.add_dependency(added.dependency, added.data_transfer);
+    }
+}
+
+// repairs the schedule in place after the delta was applied to the workflow,
+// returns the number of rescheduled tasks
+
+// only the directly affected tasks (updated workload, scheduled on the failed node or target of a
+// new dependency) and all of their descendants are removed, all other tasks keep their intervals,
+// since no predecessor of an unaffected task is affected, these intervals stay valid
+// the affected tasks are then inserted in the order of their previous start times (made monotone
+// along the dependencies) into the node with the best EFT as for HEFT
+// the scratch data only holds the affected cone, but every insertion costs as much as in HEFT,
+// i.e. it also scans the intervals of the unaffected tasks on the candidate nodes
+template <cluster::cost_model M>
+size_t repair_schedule(
+    schedule<M> & s,
+    workflow::workflow const & w,
+    schedule_delta const & delta
+) {
+    if (!s.is_complete(w)) {
+        throw std::invalid_argument("Only complete schedules can be repaired.");
+    }
+
+    std::vector<workflow::task_id> affected_task_ids{};
+    // affected task -> previous start time, a new dependency might contradict them
+    std::unordered_map<workflow::task_id, util::timepoint> keys{};
+
+    auto const mark_affected = [&] (workflow::task_id const t_id) {
+        if (t_id >= w.size()) {
+            throw std::invalid_argument("The affected task id is not part of the workflow.");
+        }
+
+        if (keys.try_emplace(t_id, 0.0).second) {
+            affected_task_ids.push_back(t_id);
+        }
+    };
+
+    for (workload_update const & update : delta.workload_updates) {
+        mark_affected(update.t_id);
+    }
+
+    for (added_dependency const & added : delta.added_dependencies) {
+        mark_affected(added.dependency.to_id);
+    }
+
+    if (delta.failed_node) {
+        for (workflow::task_id const t_id : s.get_tasks_of_node(delta.failed_node.value())) {
+            mark_affected(t_id);
+        }
+
+        s.disable_node(delta.failed_node.value());
+    }
+
+    // downstream cone, the vector is extended while it is traversed
+    for (size_t i = 0; i < affected_task_ids.size(); ++i) {
+        for (auto const & [succ_id, data_transfer] : w.get_task_outgoing_edges(affected_task_ids[i])) {
+            mark_affected(succ_id);
+        }
+    }
+
+    std::ranges::sort(affected_task_ids, {}, [&w] (workflow::task_id const t_id) {
+        return w.topological_task_rank(t_id);
+    });
+
+    for (workflow::task_id const t_id : affected_task_ids) {
+        util::timepoint & key = keys.at(t_id);
+        key = s.get_task_intervals(t_id).front().start;
+
+        for (auto const & [pred_id, data_transfer] : w.get_task_incoming_edges(t_id)) {
+            auto const it = keys.find(pred_id);
+
+            if (it != keys.end()) {
+                key = std::max(key, it->second);
+            }
+        }
+    }
+
+    for (workflow::task_id const t_id : affected_task_ids) {
+        s.remove_task(t_id);
+    }
+
+    // ties keep the topological order
+    std::ranges::stable_sort(affected_task_ids, {}, [&keys] (workflow::task_id const t_id) {
+        return keys.at(t_id);
+    });
+
+    for (workflow::task_id const t_id : affected_task_ids) {
+        s.insert_into_best_eft_node_schedule(t_id, w);
+    }
+
+    return affected_task_ids.size();
+}
+
+} // namespace schedule
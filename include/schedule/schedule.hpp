@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <optional>
 #include <sstream>
 #include <ranges>
@@ -9,22 +10,44 @@
 #include <vector>
 
 #include <cluster/cluster.hpp>
+#include <cluster/cost_model.hpp>
 #include <schedule/node_schedule.hpp>
 #include <schedule/time_interval.hpp>
 #include <util/epsilon_compare.hpp>
+#include <util/parallel_for.hpp>
 #include <util/timepoint.hpp>
-#include <workflow/data_transfer_cost.hpp>
+#include <util/trace.hpp>
 #include <workflow/workflow.hpp>
 
 namespace schedule {
 
+// M is the cost model that defines computation times and data transfer costs
+template <cluster::cost_model M>
 class schedule {
     bool use_memory_requirements;
+    M model;
 
     // cluster node id/index -> list of scheduled tasks
     std::vector<node_schedule> node_schedules{};
-    std::unordered_map<workflow::task_id, std::vector<time_interval>> task_intervals{};
-    std::unordered_map<scheduled_task_id, workflow::task_id> scheduled_to_original_task_id{};
+    // task id -> intervals, empty for tasks that are not scheduled, the vectors are only
+    // cleared on a reset such that a schedule that is reused doesn't allocate again
+    std::vector<std::vector<time_interval>> task_intervals{};
+    size_t num_scheduled_tasks{0};
+    // scheduled task id -> task id, the entries of removed tasks stay, so the size is the next id
+    std::vector<workflow::task_id> scheduled_to_original_task_id{};
+
+    // task id -> earliest start time, empty if all tasks can start at time 0
+    std::vector<util::timepoint> release_times{};
+
+    // everything that is needed to take back an insertion
+    struct insertion_record {
+        workflow::task_id t_id;
+        cluster::node_id n_id;
+        size_t position_in_node_schedule;
+    };
+
+    bool log_insertions{false};
+    std::vector<insertion_record> undo_log{};
 
 public:
     struct scheduled_edge {
@@ -35,10 +58,30 @@ public:
     };
 
     schedule(cluster::cluster const & c, bool const use_memory_requirements_) 
-        : use_memory_requirements{use_memory_requirements_} {
+        : use_memory_requirements{use_memory_requirements_}, model(c) {
         for (cluster::cluster_node const & node : c) {
-            node_schedules.emplace_back(node);
+            node_schedules.emplace_back(node, c.get_core_model());
+        }
+    }
+
+    // removes all tasks, release times and disabled nodes but keeps the allocated memory,
+    // the cluster stays the one the schedule was constructed with
+    void reset(bool const use_memory_requirements_) {
+        use_memory_requirements = use_memory_requirements_;
+
+        for (node_schedule & node_s : node_schedules) {
+            node_s.clear();
         }
+
+        for (std::vector<time_interval> & intervals : task_intervals) {
+            intervals.clear();
+        }
+
+        num_scheduled_tasks = 0;
+        scheduled_to_original_task_id.clear();
+        release_times.clear();
+        log_insertions = false;
+        undo_log.clear();
     }
 
     void insert_into_node_schedule(
@@ -52,15 +95,10 @@ public:
         
         double const ready_time = task_ready_time(t_id, w, n_id, unscheduled_predecessors_allowed);
         
-        auto slot = node_s.compute_earliest_finish_time(ready_time, t);
+        util::timepoint const computation_time = model.computation_time(t.workload, n_id);
+        auto slot = node_s.compute_earliest_finish_time(ready_time, computation_time);
 
-        util::timepoint const start = slot.eft - node_s.get_computation_time(t);
-        scheduled_task_id const sched_t_id = scheduled_to_original_task_id.size();
-        time_interval best_interval{start, slot.eft, sched_t_id, n_id};
-
-        add_scheduled_task(t_id, best_interval);
-        scheduled_to_original_task_id.insert({sched_t_id, t_id});
-        node_s.insert(slot.it, best_interval);
+        insert_interval(t_id, n_id, slot);
     }
 
     cluster::node_id insert_into_best_eft_node_schedule(
@@ -68,71 +106,125 @@ public:
         workflow::workflow const & w,
         bool const use_est_instead = false
     ) {
-        workflow::task const & t = w.get_task(t_id);
-        
-        // if (t_id == 3) {
-        //     double t0 = task_ready_time(t.id, w, 0);
-        //     double eft0 = node_schedules.at(0).compute_earliest_finish_time(t0, t).eft;
-        //     std::cout << "0: " << t0 << ", " << eft0 << '\n';
-        //     double t1 = task_ready_time(t.id, w, 1);
-        //     double eft1 = node_schedules.at(1).compute_earliest_finish_time(t1, t).eft;
-        //     std::cout << "1: " << t1 << ", " << eft1 << '\n';
-        //     double t2 = task_ready_time(t.id, w, 2);
-        //     double eft2 = node_schedules.at(2).compute_earliest_finish_time(t2, t).eft;
-        //     std::cout << "2: " << t2 << ", " << eft2 << '\n';
-        // }
-
-        auto has_enough_memory = [this, &t] (node_schedule const & node_s) {
-            return use_memory_requirements 
-                ? node_s.get_node().memory >= t.memory_requirement
-                : true;
-        };
-
-        auto earliest_finish_time_of_node = [this, &w, &t] (node_schedule & node_s) {
-            cluster::node_id const node_id = node_s.get_node().id;
-            double const ready_time = task_ready_time(t.id, w, node_id);
-            return std::make_tuple(node_s.compute_earliest_finish_time(ready_time, t), node_id);
-        };
-
-        auto earliest_finish_times = node_schedules
-            | std::views::filter(has_enough_memory)
-            | std::views::transform(earliest_finish_time_of_node);
-
-        auto best_it = std::ranges::min_element(
-            earliest_finish_times,
-            {},
-            [this, &t, use_est_instead] (auto const & tup) {
-                auto const & node_s = node_schedules.at(std::get<1>(tup));
-                // if (t.id == 3) {
-                //     std::cout << std::get<1>(tup) << ", "
-                //         << std::get<0>(tup).eft << ", "
-                //         << (std::get<0>(tup).eft
-                //         - use_est_instead ? node_s.get_computation_time(t) : 0.0) << '\n';
-                // }
-                return std::get<0>(tup).eft
-                    - (use_est_instead ? node_s.get_computation_time(t) : 0.0);
+        return insert_into_best_slot(t_id, w,
+            [use_est_instead] ([[maybe_unused]] cluster::node_id const n_id, node_schedule::time_slot const & slot) {
+                return use_est_instead ? slot.start : slot.eft;
             }
         );
+    }
 
-        if (best_it == earliest_finish_times.end()) {
-            throw std::logic_error(
-                "There exists a task with a memory requirement larger than the memory of each node."
-            );
+    // inserts the task at its earliest finish time into the node schedule that minimizes 
+    // node_cost(node_id, eft) and returns the id of that node, ties are broken by the lower node id
+    template <typename F>
+    cluster::node_id insert_into_best_node_schedule(
+        workflow::task_id const t_id,
+        workflow::workflow const & w,
+        F const & node_cost
+    ) {
+        return insert_into_best_slot(t_id, w,
+            [&node_cost] (cluster::node_id const n_id, node_schedule::time_slot const & slot) {
+                return node_cost(n_id, slot.eft);
+            }
+        );
+    }
+
+    // EFT of the task on the given node without inserting it
+    util::timepoint earliest_finish_time(
+        workflow::task_id const t_id,
+        workflow::workflow const & w,
+        cluster::node_id const n_id,
+        bool const unscheduled_predecessors_allowed = false
+    ) {
+        double const ready_time = task_ready_time(t_id, w, n_id, unscheduled_predecessors_allowed);
+        util::timepoint const computation_time = model.computation_time(w.get_task(t_id).workload, n_id);
+
+        return node_schedules.at(n_id).compute_earliest_finish_time(ready_time, computation_time).eft;
+    }
+
+    // EFT on the given node for a task with known ready and computation time without inserting it
+    util::timepoint earliest_finish_time(
+        cluster::node_id const n_id,
+        util::timepoint const ready_time,
+        util::timepoint const computation_time
+    ) {
+        return node_schedules.at(n_id).compute_earliest_finish_time(ready_time, computation_time).eft;
+    }
+
+    // all insertions after this call are recorded until they are rolled back, 
+    // such that a tentative placement doesn't need a copy of the schedule
+    void begin_tentative_insertions() {
+        undo_log.clear();
+        log_insertions = true;
+    }
+
+    // takes back all insertions since begin_tentative_insertions in reverse order
+    void rollback_tentative_insertions() {
+        while (!undo_log.empty()) {
+            insertion_record const & record = undo_log.back();
+            auto & intervals = task_intervals.at(record.t_id);
+
+            intervals.pop_back();
+            if (intervals.empty()) {
+                --num_scheduled_tasks;
+            }
+
+            node_schedules.at(record.n_id).erase(record.position_in_node_schedule);
+            scheduled_to_original_task_id.pop_back();
+            undo_log.pop_back();
         }
 
-        auto const [slot, node_id] = *best_it;
+        log_insertions = false;
+    }
 
-        node_schedule & best_node_s = node_schedules.at(node_id);
+    // no task starts before its release time, this must be set before any task is inserted
+    void set_release_times(std::vector<util::timepoint> release_times_) {
+        release_times = std::move(release_times_);
+    }
 
-        util::timepoint const start = slot.eft - best_node_s.get_computation_time(t);
-        scheduled_task_id const sched_t_id = scheduled_to_original_task_id.size();
-        time_interval best_interval{start, slot.eft, sched_t_id, node_id};
+    // removes all intervals (including duplicates) of the task, which must be scheduled
+    void remove_task(workflow::task_id const t_id) {
+        if (!is_scheduled(t_id)) {
+            throw std::runtime_error("Internal bug: a task that is not scheduled should be removed.");
+        }
 
-        add_scheduled_task(t_id, best_interval);
-        scheduled_to_original_task_id.insert({sched_t_id, t_id});
-        best_node_s.insert(slot.it, best_interval);
+        for (time_interval const & interval : task_intervals[t_id]) {
+            node_schedule & node_s = node_schedules.at(interval.node_id);
+            node_s.erase(node_s.find(interval));
+        }
 
-        return node_id;
+        task_intervals[t_id].clear();
+        --num_scheduled_tasks;
+    }
+
+    // the node keeps its current tasks but no further tasks are inserted into it
+    void disable_node(cluster::node_id const n_id) {
+        node_schedules.at(n_id).disable();
+    }
+
+    bool is_scheduled(workflow::task_id const t_id) const {
+        return t_id < task_intervals.size() && !task_intervals[t_id].empty();
+    }
+
+    // the first interval is the one that was inserted first, the others are duplicates
+    std::vector<time_interval> const & get_task_intervals(workflow::task_id const t_id) const {
+        if (!is_scheduled(t_id)) {
+            throw std::out_of_range("The task is not scheduled.");
+        }
+
+        return task_intervals[t_id];
+    }
+
+    // false if the computation of the schedule was stopped before all tasks were inserted
+    bool is_complete(workflow::workflow const & w) const {
+        return num_scheduled_tasks == w.size();
+    }
+
+    size_t num_nodes() const {
+        return node_schedules.size();
+    }
+
+    std::vector<node_schedule> const & get_node_schedules() const {
+        return node_schedules;
     }
 
     util::timepoint get_makespan() const {
@@ -167,67 +259,178 @@ public:
         return out.str();
     }
 
-    bool is_valid(workflow::workflow const & w) const {
+    struct validation_result {
+        bool valid;
+        // node_communication[source][target] -> total sum of data transfer from source to target
+        // only filled if the schedule is valid
+        std::vector<std::vector<double>> node_communication;
+    };
+
+    // checks node overlaps, completeness, precedence and data arrival times and accumulates
+    // the node communication matrix in the same single pass over all intervals and edges
+    // the pass is parallelized over tasks with per-thread matrices that are summed up in the end
+    validation_result validate(workflow::workflow const & w) const {
+        TRACE_SPAN("schedule", "validation");
+        size_t const num_nodes = node_schedules.size();
+
         for (node_schedule const & node_s : node_schedules) {
             if (!node_s.is_valid()) {
-                return false;
+                return {false, {}};
             }
         }
 
-        for (workflow::task const & t : w) {
-            if (!task_intervals.contains(t.id)) {
-                return false;
+        // index the intervals once such that the parallel pass doesn't need any hash lookups
+        std::vector<std::vector<time_interval> const *> intervals_of_task(w.size(), nullptr);
+
+        for (workflow::task_id t_id = 0; t_id < std::min(task_intervals.size(), w.size()); ++t_id) {
+            if (!task_intervals[t_id].empty()) {
+                intervals_of_task[t_id] = &task_intervals[t_id];
             }
         }
-        
-        for (workflow::task const & t : w) {
-            for (time_interval const & curr_t_interval : task_intervals.at(t.id)) {
-                for (auto const & [predecessor_id, data_transfer] : w.get_task_incoming_edges(t.id)) {
 
-                    auto const predecessor_interval_opt = find_predecessor_interval(
-                        predecessor_id,
-                        curr_t_interval,
-                        data_transfer
-                    );
+        if (std::ranges::find(intervals_of_task, nullptr) != intervals_of_task.end()) {
+            return {false, {}};
+        }
+
+        // bound the memory used by the per-thread matrices to about 128 MiB
+        size_t const max_threads_for_memory = std::max(
+            (1ul << 24) / std::max(num_nodes * num_nodes, 1ul), 
+            1ul
+        );
+        size_t const num_threads = std::min(
+            util::num_worker_threads(w.size(), 1024),
+            max_threads_for_memory
+        );
+
+        std::vector<std::vector<double>> thread_node_communication(num_threads);
+        std::atomic<bool> valid{true};
+
+        util::parallel_for_chunks(w.size(), num_threads, 
+            [&] (size_t const chunk_id, workflow::task_id const first_t_id, workflow::task_id const last_t_id) {
+                // flat row-major num_nodes x num_nodes matrix of this thread
+                std::vector<double> & node_communication = thread_node_communication.at(chunk_id);
+                node_communication.assign(num_nodes * num_nodes, 0.0);
+
+                for (workflow::task_id t_id = first_t_id; t_id < last_t_id; ++t_id) {
+                    if (!valid.load(std::memory_order_relaxed)) {
+                        return;
+                    }
 
-                    if (!predecessor_interval_opt) {
-                        return false;
+                    for (time_interval const & curr_t_interval : *intervals_of_task[t_id]) {
+                        cluster::node_id const target_node_id = curr_t_interval.node_id;
+
+                        if (
+                            !release_times.empty() 
+                            && util::epsilon_less(curr_t_interval.start, release_times[t_id])
+                        ) {
+                            valid.store(false, std::memory_order_relaxed);
+                            return;
+                        }
+
+                        for (auto const & [predecessor_id, data_transfer] : w.get_task_incoming_edges(t_id)) {
+                            auto const predecessor_interval_opt = find_predecessor_interval(
+                                *intervals_of_task[predecessor_id],
+                                curr_t_interval,
+                                data_transfer
+                            );
+
+                            if (!predecessor_interval_opt) {
+                                valid.store(false, std::memory_order_relaxed);
+                                return;
+                            }
+
+                            cluster::node_id const source_node_id = predecessor_interval_opt->node_id;
+
+                            node_communication[source_node_id * num_nodes + target_node_id] += 
+                                model.raw_data_transfer_cost(data_transfer, source_node_id, target_node_id);
+                        }
                     }
                 }
             }
+        );
+
+        if (!valid) {
+            return {false, {}};
         }
-        return true;
+
+        std::vector<std::vector<double>> node_communication(
+            num_nodes,
+            std::vector<double>(num_nodes, 0.0)
+        );
+
+        for (auto const & thread_matrix : thread_node_communication) {
+            for (cluster::node_id source = 0; source < num_nodes; ++source) {
+                for (cluster::node_id target = 0; target < num_nodes; ++target) {
+                    node_communication[source][target] += thread_matrix[source * num_nodes + target];
+                }
+            }
+        }
+
+        return {true, std::move(node_communication)};
+    }
+
+    bool is_valid(workflow::workflow const & w) const {
+        return validate(w).valid;
     }
 
     // node_communication[source][target] -> total sum of data transfer from source to target
     std::vector<std::vector<double>> compute_node_communication_matrix(workflow::workflow const & w) const {
-        std::vector<std::vector<double>> node_communication(
-            node_schedules.size(),
-            std::vector<double>(node_schedules.size(), 0.0)
-        );
-        
-        for (workflow::task const & t : w) {
-            for (time_interval const & curr_t_interval : task_intervals.at(t.id)) {
-                cluster::node_id const & target_node_id = curr_t_interval.node_id;
-                
-                for (auto const & [predecessor_id, data_transfer] : w.get_task_incoming_edges(t.id)) {
-                    auto const predecessor_interval_opt = find_predecessor_interval(
-                        predecessor_id,
-                        curr_t_interval,
-                        data_transfer
-                    );
+        auto result = validate(w);
 
-                    cluster::node_id const & source_node_id = predecessor_interval_opt.value().node_id;
+        if (!result.valid) {
+            throw std::runtime_error("Internal bug: Node communication of an invalid schedule requested.");
+        }
 
-                    node_communication.at(source_node_id).at(target_node_id) += workflow::get_raw_data_transfer_cost(
-                        data_transfer,
-                        node_schedules.at(source_node_id).get_node().network_bandwidth
-                    );
-                } 
+        return std::move(result.node_communication);
+    }
+
+    // calls func(original_task_id, interval, is_duplicate) for every interval in node order
+    // without building any intermediate data structure, the first interval of a task
+    // that was inserted into this schedule is not considered to be a duplicate
+    template <typename F>
+    void for_each_interval(F && func) const {
+        for (node_schedule const & node_s : node_schedules) {
+            for (time_interval const & interval : node_s.get_intervals()) {
+                workflow::task_id const t_id = scheduled_to_original_task_id.at(interval.task_id);
+                bool const is_duplicate = task_intervals[t_id].front().task_id != interval.task_id;
+                func(t_id, interval, is_duplicate);
+            }
+        }
+    }
+
+    // node of the first interval of every task, duplicates are ignored
+    std::vector<cluster::node_id> get_task_assignment(workflow::workflow const & w) const {
+        std::vector<cluster::node_id> assignment(w.size());
+
+        for (workflow::task_id t_id = 0; t_id < task_intervals.size(); ++t_id) {
+            if (!task_intervals[t_id].empty()) {
+                assignment.at(t_id) = task_intervals[t_id].front().node_id;
+            }
+        }
+
+        return assignment;
+    }
+
+    // all tasks sorted by the start of their first interval, the keys are made monotone along
+    // the edges such that every task comes after its predecessors even if it used a duplicate
+    std::vector<workflow::task_id> get_task_start_order(workflow::workflow const & w) const {
+        std::vector<util::timepoint> keys(w.size());
+
+        for (workflow::task_id const t_id : w.get_task_topological_order()) {
+            keys[t_id] = get_task_intervals(t_id).front().start;
+
+            for (auto const & [pred_id, data_transfer] : w.get_task_incoming_edges(t_id)) {
+                keys[t_id] = std::max(keys[t_id], keys[pred_id]);
             }
         }
 
-        return node_communication;
+        // ties keep the topological order
+        std::vector<workflow::task_id> order = w.get_task_topological_order();
+        std::ranges::stable_sort(order, {}, [&keys] (workflow::task_id const t_id) {
+            return keys[t_id];
+        });
+
+        return order;
     }
 
     std::vector<workflow::task_id> get_tasks_of_node(cluster::node_id const n_id) const {
@@ -242,11 +445,55 @@ public:
         return task_ids;
     }
 
+    // calls func(pred_t_id, pred_interval, t_id, interval, data_transfer, data_transfer_cost) for every
+    // interval of every task and each of its incoming edges with the predecessor interval that sends
+    // the data, without building the list of edges, edges whose data doesn't arrive in time only exist
+    // in invalid schedules and are skipped
+    template <typename F>
+    void for_each_data_edge(workflow::workflow const & w, F && func) const {
+        for_each_interval([&] (
+            workflow::task_id const t_id,
+            time_interval const & interval,
+            [[maybe_unused]] bool const is_duplicate
+        ) {
+            for (auto const & [pred_t_id, data_transfer] : w.get_task_incoming_edges(t_id)) {
+                auto const pred_interval_opt = find_predecessor_interval(pred_t_id, interval, data_transfer);
+
+                if (pred_interval_opt) {
+                    util::timepoint const data_transfer_cost = model.data_transfer_cost(
+                        data_transfer,
+                        pred_interval_opt->node_id,
+                        interval.node_id
+                    );
+
+                    func(pred_t_id, pred_interval_opt.value(), t_id, interval, data_transfer, data_transfer_cost);
+                }
+            }
+        });
+    }
+
+    // the data edges whose data is sent from one node to another
+    template <typename F>
+    void for_each_different_node_edge(workflow::workflow const & w, F && func) const {
+        for_each_data_edge(w, [&func] (
+            workflow::task_id const pred_t_id,
+            time_interval const & pred_interval,
+            workflow::task_id const t_id,
+            time_interval const & interval,
+            [[maybe_unused]] double const data_transfer,
+            [[maybe_unused]] util::timepoint const data_transfer_cost
+        ) {
+            if (pred_interval.node_id != interval.node_id) {
+                func(pred_t_id, pred_interval, t_id, interval);
+            }
+        });
+    }
+
     std::vector<scheduled_edge> get_different_node_edges(workflow::workflow const & w) const {
         std::vector<scheduled_edge> edges;
         
-        for (auto const & [curr_t_id, curr_t_intervals] : task_intervals) {
-            for (auto const & curr_t_interval : curr_t_intervals) {
+        for (workflow::task_id curr_t_id = 0; curr_t_id < task_intervals.size(); ++curr_t_id) {
+            for (auto const & curr_t_interval : task_intervals[curr_t_id]) {
                 for (auto const & [pred_t_id, data_transfer] : w.get_task_incoming_edges(curr_t_id)) {
                     auto const pred_t_interval_opt = find_predecessor_interval(
                         pred_t_id,
@@ -275,6 +522,63 @@ public:
     }
 
 private:
+    // inserts the task into the slot of the node schedule that minimizes slot_cost(node_id, slot)
+    // and returns the id of that node, ties are broken by the lower node id
+    template <typename F>
+    cluster::node_id insert_into_best_slot(
+        workflow::task_id const t_id,
+        workflow::workflow const & w,
+        F const & slot_cost
+    ) {
+        workflow::task const & t = w.get_task(t_id);
+
+        // every node is evaluated exactly once
+        std::optional<cluster::node_id> best_node_id{};
+        double best_cost{};
+        std::optional<node_schedule::time_slot> best_slot{};
+        bool any_node_enabled = false;
+
+        for (node_schedule & node_s : node_schedules) {
+            cluster::cluster_node const & node = node_s.get_node();
+
+            if (node_s.is_disabled()) {
+                continue;
+            }
+
+            any_node_enabled = true;
+
+            if (use_memory_requirements && node.memory < t.memory_requirement) {
+                continue;
+            }
+
+            double const ready_time = task_ready_time(t_id, w, node.id);
+            util::timepoint const computation_time = model.computation_time(t.workload, node.id);
+            auto const slot = node_s.compute_earliest_finish_time(ready_time, computation_time);
+            double const cost = slot_cost(node.id, slot);
+
+            if (!best_node_id || cost < best_cost) {
+                best_node_id = node.id;
+                best_cost = cost;
+                best_slot.emplace(slot);
+            }
+        }
+
+        if (!any_node_enabled) {
+            throw std::runtime_error("All nodes of the cluster are disabled, e.g. after node failures.");
+        }
+
+        if (!best_node_id) {
+            throw std::logic_error(
+                "There exists a task with a memory requirement larger than the memory of each node."
+            );
+        }
+
+        cluster::node_id const node_id = best_node_id.value();
+        insert_interval(t_id, node_id, best_slot.value());
+
+        return node_id;
+    }
+
     util::timepoint task_ready_time(
         workflow::task_id const t_id,
         workflow::workflow const & w,
@@ -285,7 +589,7 @@ private:
             | std::views::transform([this, target_node_id, unscheduled_predecessors_allowed] (auto const & edge) {
                 auto const & [predecessor_t_id, data_transfer] = edge;
 
-                if (unscheduled_predecessors_allowed && !task_intervals.contains(predecessor_t_id)) {
+                if (unscheduled_predecessors_allowed && !is_scheduled(predecessor_t_id)) {
                     return 0.0;
                 }
 
@@ -294,7 +598,9 @@ private:
         );
 
         auto latest_it = std::ranges::max_element(data_available_times);
-        return latest_it != data_available_times.end() ? *latest_it : 0.0;
+        util::timepoint const release_time = release_times.empty() ? 0.0 : release_times[t_id];
+
+        return latest_it != data_available_times.end() ? std::max(*latest_it, release_time) : release_time;
     }
 
     // due to possible duplication, find best connection to get the needed data
@@ -303,15 +609,18 @@ private:
         cluster::node_id const target_node_id,
         double const data_transfer
     ) const {
-        auto const & intervals = task_intervals.at(predecessor_t_id);
+        if (!is_scheduled(predecessor_t_id)) {
+            throw std::runtime_error("Internal Bug: Predecessor task does not have any schedule yet.");
+        }
+
+        auto const & intervals = task_intervals[predecessor_t_id];
 
         auto data_available_times = intervals 
             | std::views::transform([this, target_node_id, data_transfer] (time_interval const & interval) {
-                return interval.end + workflow::get_data_transfer_cost(
-                    interval.node_id, 
-                    target_node_id,
+                return interval.end + model.data_transfer_cost(
                     data_transfer,
-                    node_schedules.at(interval.node_id).get_node().network_bandwidth
+                    interval.node_id, 
+                    target_node_id
                 );
             });
 
@@ -324,18 +633,33 @@ private:
         return *earliest_it;
     }
 
+    void insert_interval(
+        workflow::task_id const t_id,
+        cluster::node_id const n_id,
+        node_schedule::time_slot const & slot
+    ) {
+        scheduled_task_id const sched_t_id = scheduled_to_original_task_id.size();
+        time_interval const interval{slot.start, slot.eft, sched_t_id, n_id, slot.cores};
+
+        add_scheduled_task(t_id, interval);
+        scheduled_to_original_task_id.push_back(t_id);
+        size_t const position = node_schedules.at(n_id).insert(slot.it, interval);
+
+        if (log_insertions) {
+            undo_log.push_back({t_id, n_id, position});
+        }
+    }
+
     void add_scheduled_task(workflow::task_id const t_id, time_interval const interval) {
-        if (!task_intervals.contains(t_id)) {
-            auto const [it, inserted] = task_intervals.insert({t_id, std::vector<time_interval>()});
+        if (t_id >= task_intervals.size()) {
+            task_intervals.resize(t_id + 1);
+        }
 
-            if (!inserted || it->first != t_id) {
-                throw std::runtime_error("Internal bug: Task interval was not inserted correctly.");
-            }
-            
-            it->second.push_back(interval);
-        } else {
-            task_intervals.at(t_id).push_back(interval);
+        if (task_intervals[t_id].empty()) {
+            ++num_scheduled_tasks;
         }
+
+        task_intervals[t_id].push_back(interval);
     }
 
     std::optional<time_interval> find_predecessor_interval(
@@ -343,12 +667,23 @@ private:
         time_interval const curr_t_interval,
         util::timepoint const data_transfer
     ) const {
-        for (time_interval const & predecessor_interval : task_intervals.at(predecessor_id)) {
-            double const data_transfer_cost = workflow::get_data_transfer_cost(
-                curr_t_interval.node_id, 
-                predecessor_interval.node_id, 
+        return find_predecessor_interval(
+            get_task_intervals(predecessor_id),
+            curr_t_interval,
+            data_transfer
+        );
+    }
+
+    std::optional<time_interval> find_predecessor_interval(
+        std::vector<time_interval> const & predecessor_intervals,
+        time_interval const curr_t_interval,
+        util::timepoint const data_transfer
+    ) const {
+        for (time_interval const & predecessor_interval : predecessor_intervals) {
+            double const data_transfer_cost = model.data_transfer_cost(
                 data_transfer,
-                node_schedules.at(curr_t_interval.node_id).get_node().network_bandwidth
+                predecessor_interval.node_id, 
+                curr_t_interval.node_id
             );
 
             // epsilon for floating point comparison
@@ -15,6 +15,8 @@ struct time_interval {
     util::timepoint end;
     scheduled_task_id task_id;
     cluster::node_id node_id;
+    // number of used cores in the core model, 0 if the task uses the whole node
+    size_t cores{0};
 };
 
 } // namespace schedule
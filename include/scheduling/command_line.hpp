@@ -0,0 +1,8 @@
+#pragma once
+
+namespace scheduling {
+
+// everything the static_task_scheduling executable does, returns its exit code
+int run_command_line(int argc, char * argv[]);
+
+} // namespace scheduling
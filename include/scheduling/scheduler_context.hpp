@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+// the stable interface of the scheduling library, it only depends on the standard library, so
+// programs that link the library don't need the headers of its dependencies
+
+namespace scheduling {
+
+struct cluster_options {
+    // at most one of both can be given
+    std::string rack_input{};
+    std::string link_input{};
+
+    // every task runs on 1 to max_cores_per_task cores of its node with Amdahl's law,
+    // 0 means all cores of the node, a min_efficiency of 0 means no efficiency limit
+    bool core_model{false};
+    double parallel_fraction{0.0};
+    size_t max_cores_per_task{0};
+    double min_efficiency{0.0};
+};
+
+struct scheduler_options {
+    bool use_memory_requirements{false};
+    bool validate{true};
+
+    // the genetic algorithm stops at whichever limit is reached first, 0 means no limit
+    size_t ga_generations{50};
+    size_t ga_time_ms{0};
+};
+
+struct task_placement {
+    size_t task_id;
+    size_t node_id;
+    double start;
+    double end;
+    // number of used cores in the core model, 0 if the task uses the whole node
+    size_t cores;
+    bool is_duplicate;
+};
+
+struct schedule_result {
+    std::string algorithm{};
+    double makespan{0.0};
+    // always true if the schedule isn't validated
+    bool valid{true};
+    std::vector<task_placement> placements{};
+};
+
+using workflow_handle = size_t;
+
+// a loaded cluster together with any number of loaded workflows, the upward and downward ranks
+// of every workflow are computed once and read in place, the schedule and the buffers of the
+// result are reset and reused by every call of schedule, a context must not be used by several
+// threads at the same time
+class scheduler_context {
+public:
+    explicit scheduler_context(std::string const & cluster_input, cluster_options const & options = {});
+    ~scheduler_context();
+
+    scheduler_context(scheduler_context &&) noexcept;
+    scheduler_context & operator=(scheduler_context &&) noexcept;
+
+    // the dependencies are inferred from the topology if no dependency file is given
+    workflow_handle load_workflow(
+        std::string const & task_bag_input,
+        std::string const & topology,
+        std::string const & dependency_input = {}
+    );
+
+    size_t num_nodes() const;
+    size_t num_tasks(workflow_handle const handle) const;
+
+    // the algorithm is given by its name as on the command line, e.g. heft or cpop,
+    // the result stays valid until the next call of schedule
+    schedule_result const & schedule(
+        workflow_handle const handle,
+        std::string const & algorithm,
+        scheduler_options const & options = {}
+    );
+
+private:
+    struct impl;
+    std::unique_ptr<impl> pimpl;
+};
+
+} // namespace scheduling
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace util {
+
+// unbounded FIFO queue for several producers and consumers, pop blocks until an item
+// arrives or the queue is closed
+template <typename T>
+class blocking_queue {
+    std::mutex mutex{};
+    std::condition_variable cv{};
+    std::deque<T> items{};
+    bool closed{false};
+
+public:
+    void push(T item) {
+        {
+            std::lock_guard<std::mutex> const lock(mutex);
+            items.push_back(std::move(item));
+        }
+
+        cv.notify_one();
+    }
+
+    // std::nullopt after the queue was closed and all items were popped
+    std::optional<T> pop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] () {
+            return !items.empty() || closed;
+        });
+
+        if (items.empty()) {
+            return std::nullopt;
+        }
+
+        T item = std::move(items.front());
+        items.pop_front();
+
+        return item;
+    }
+
+    // wakes up all waiting consumers, the remaining items can still be popped
+    void close() {
+        {
+            std::lock_guard<std::mutex> const lock(mutex);
+            closed = true;
+        }
+
+        cv.notify_all();
+    }
+};
+
+} // namespace util
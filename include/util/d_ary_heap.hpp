@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace util {
+
+// max heap of ids with D children per node, the ids are ordered by a comparator that usually
+// looks up precomputed keys, so the heap itself is a flat array of ids that is allocated once,
+// the comparator must be a strict total order for a deterministic pop order
+template <size_t D, typename Less>
+class d_ary_heap {
+    static_assert(D >= 2, "A d-ary heap needs at least two children per node.");
+
+    std::vector<size_t> ids{};
+    Less less;
+
+public:
+    d_ary_heap(size_t const capacity, Less less_) : less{std::move(less_)} {
+        ids.reserve(capacity);
+    }
+
+    bool empty() const {
+        return ids.empty();
+    }
+
+    size_t size() const {
+        return ids.size();
+    }
+
+    size_t top() const {
+        return ids.front();
+    }
+
+    void push(size_t const id) {
+        ids.push_back(id);
+        sift_up(ids.size() - 1);
+    }
+
+    size_t pop() {
+        size_t const top_id = ids.front();
+        ids.front() = ids.back();
+        ids.pop_back();
+
+        if (!ids.empty()) {
+            sift_down(0);
+        }
+
+        return top_id;
+    }
+
+private:
+    void sift_up(size_t i) {
+        size_t const id = ids[i];
+
+        while (i > 0) {
+            size_t const parent = (i - 1) / D;
+            if (!less(ids[parent], id)) {
+                break;
+            }
+
+            ids[i] = ids[parent];
+            i = parent;
+        }
+
+        ids[i] = id;
+    }
+
+    void sift_down(size_t i) {
+        size_t const id = ids[i];
+        size_t const n = ids.size();
+
+        while (true) {
+            size_t const first_child = D * i + 1;
+            if (first_child >= n) {
+                break;
+            }
+
+            size_t const last_child = std::min(first_child + D, n);
+            size_t max_child = first_child;
+
+            for (size_t child = first_child + 1; child < last_child; ++child) {
+                if (less(ids[max_child], ids[child])) {
+                    max_child = child;
+                }
+            }
+
+            if (!less(id, ids[max_child])) {
+                break;
+            }
+
+            ids[i] = ids[max_child];
+            i = max_child;
+        }
+
+        ids[i] = id;
+    }
+};
+
+} // namespace util
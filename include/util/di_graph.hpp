@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <optional>
 #include <ranges>
 #include <unordered_map>
@@ -60,6 +61,10 @@ public:
         return vertices.at(v_id);
     }
 
+    V & get_vertex(vertex_id const v_id) {
+        return vertices.at(v_id);
+    }
+
     std::vector<V> const & get_all_vertices() const {
         return vertices;
     }
@@ -93,39 +98,99 @@ public:
         return independent_vertex_ids;
     }
 
+    struct topological_sorting {
+        // all vertices sorted by (level, id)
+        std::vector<vertex_id> order;
+
+        // vertex id -> length of the longest path from an independent vertex to it
+        std::vector<size_t> levels;
+
+        // the vertices of level l are order[level_offsets[l]] until order[level_offsets[l + 1] - 1]
+        std::vector<size_t> level_offsets;
+    };
+
+    // vertex id -> number of incoming edges
+    std::vector<size_t> in_degrees() const {
+        std::vector<size_t> degrees(vertices.size());
+
+        for (vertex_id v_id = 0; v_id < vertices.size(); ++v_id) {
+            degrees[v_id] = incoming_edges[v_id].size();
+        }
+
+        return degrees;
+    }
+
+    // Kahn's algorithm using only an in-degree counter per vertex and a FIFO queue,
+    // the levels are computed along the way and the vertices are then bucketed by level
     // returns a std::nullopt if the graph is cyclic
-    // running time: linear in the number of edges
-    std::optional<std::vector<vertex_id>> topological_order() const {
-        std::vector<vertex_id> topological_order{};
-        std::unordered_set<vertex_id> independent_vertex_ids = get_independent_vertex_ids();
-
-        // copy incoming edges to modify
-        auto temp_incoming_edges = incoming_edges;
-
-        // keep on finding "independent" vertices without incoming edges
-        // then extract them and delete their outgoing edges to make other vertices independent
-        while (!independent_vertex_ids.empty()) {
-            vertex_id const curr_vertex_id = *independent_vertex_ids.begin();
-            independent_vertex_ids.erase(curr_vertex_id);
-            topological_order.push_back(curr_vertex_id);
-
-            for (auto const & [neighbor_id, weight] : outgoing_edges.at(curr_vertex_id)) {
-                size_t const num_erased = temp_incoming_edges.at(neighbor_id).erase(curr_vertex_id);
-                if (num_erased != 1) {
-                    return std::nullopt;
-                }
+    // running time: linear in the number of vertices and edges, deterministic output
+    std::optional<topological_sorting> topological_sort() const {
+        size_t const num_vertices = vertices.size();
+
+        std::vector<size_t> remaining_in_degrees = in_degrees();
+        std::vector<size_t> levels(num_vertices, 0);
+
+        // the FIFO queue is a vector with a separate read position, each vertex is pushed once
+        std::vector<vertex_id> queue{};
+        queue.reserve(num_vertices);
+
+        for (vertex_id v_id = 0; v_id < num_vertices; ++v_id) {
+            if (remaining_in_degrees[v_id] == 0) {
+                queue.push_back(v_id);
+            }
+        }
 
-                if (temp_incoming_edges.at(neighbor_id).empty()) {
-                    independent_vertex_ids.insert(neighbor_id);
+        size_t num_levels = num_vertices == 0 ? 0 : 1;
+
+        for (size_t queue_pos = 0; queue_pos < queue.size(); ++queue_pos) {
+            vertex_id const curr_vertex_id = queue[queue_pos];
+            size_t const next_level = levels[curr_vertex_id] + 1;
+
+            for (auto const & [neighbor_id, weight] : outgoing_edges[curr_vertex_id]) {
+                levels[neighbor_id] = std::max(levels[neighbor_id], next_level);
+
+                if (--remaining_in_degrees[neighbor_id] == 0) {
+                    queue.push_back(neighbor_id);
+                    num_levels = std::max(num_levels, next_level + 1);
                 }
             }
         }
 
-        if (topological_order.size() != vertices.size()) {
+        if (queue.size() != num_vertices) {
+            return std::nullopt;
+        }
+
+        // counting sort of the vertex ids by level, stable in the ids
+        std::vector<size_t> level_offsets(num_levels + 1, 0);
+
+        for (size_t const level : levels) {
+            ++level_offsets[level + 1];
+        }
+
+        for (size_t level = 0; level < num_levels; ++level) {
+            level_offsets[level + 1] += level_offsets[level];
+        }
+
+        std::vector<vertex_id> order(num_vertices);
+        std::vector<size_t> next_positions(level_offsets.begin(), level_offsets.end() - 1);
+
+        for (vertex_id v_id = 0; v_id < num_vertices; ++v_id) {
+            order[next_positions[levels[v_id]]++] = v_id;
+        }
+
+        return topological_sorting{std::move(order), std::move(levels), std::move(level_offsets)};
+    }
+
+    // returns a std::nullopt if the graph is cyclic
+    // running time: linear in the number of vertices and edges
+    std::optional<std::vector<vertex_id>> topological_order() const {
+        auto sorting = topological_sort();
+
+        if (!sorting) {
             return std::nullopt;
         }
 
-        return topological_order;
+        return std::move(sorting->order);
     }
 };
 
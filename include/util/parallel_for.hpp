@@ -0,0 +1,77 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace util {
+
+// number of threads to use for num_items independent items such that every
+// thread gets at least min_items_per_thread items, always at least 1
+inline size_t num_worker_threads(size_t const num_items, size_t const min_items_per_thread) {
+    size_t const hardware_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    size_t const max_useful_threads = num_items / std::max(min_items_per_thread, 1ul);
+
+    return std::clamp(max_useful_threads, 1ul, hardware_threads);
+}
+
+// splits [0, num_items) into num_chunks contiguous chunks of (almost) equal size and calls
+// func(chunk_id, begin, end) for every chunk on its own thread, chunk 0 runs on the calling thread
+// exceptions thrown by func are rethrown on the calling thread after all threads are joined
+template <typename F>
+void parallel_for_chunks(size_t const num_items, size_t const num_chunks, F const & func) {
+    if (num_chunks <= 1) {
+        func(0ul, 0ul, num_items);
+        return;
+    }
+
+    auto const chunk_begin = [num_items, num_chunks] (size_t const chunk_id) {
+        return num_items * chunk_id / num_chunks;
+    };
+
+    std::vector<std::exception_ptr> exceptions(num_chunks);
+
+    auto const run_chunk = [&] (size_t const chunk_id) {
+        try {
+            func(chunk_id, chunk_begin(chunk_id), chunk_begin(chunk_id + 1));
+        } catch (...) {
+            exceptions.at(chunk_id) = std::current_exception();
+        }
+    };
+
+    {
+        // jthreads join on destruction, also if creating one of them fails
+        std::vector<std::jthread> workers{};
+        workers.reserve(num_chunks - 1);
+
+        for (size_t chunk_id = 1; chunk_id < num_chunks; ++chunk_id) {
+            workers.emplace_back(run_chunk, chunk_id);
+        }
+
+        run_chunk(0);
+    }
+
+    for (std::exception_ptr const & exception : exceptions) {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+}
+
+// calls func(i) for all i in [0, num_items), in parallel if there are enough items
+template <typename F>
+void parallel_for(size_t const num_items, size_t const min_items_per_thread, F const & func) {
+    size_t const num_threads = num_worker_threads(num_items, min_items_per_thread);
+
+    parallel_for_chunks(num_items, num_threads,
+        [&func] ([[maybe_unused]] size_t const chunk_id, size_t const begin, size_t const end) {
+            for (size_t i = begin; i < end; ++i) {
+                func(i);
+            }
+        }
+    );
+}
+
+} // namespace util
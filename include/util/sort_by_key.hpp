@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace util {
+
+// maps a double to an unsigned integer with the same order, i.e. the sign bit is flipped for
+// positive numbers and all bits are flipped for negative numbers, -0.0 is mapped like 0.0
+inline uint64_t ordered_bits(double const d) {
+    double const normalized = d == 0.0 ? 0.0 : d;
+    // memcpy instead of std::bit_cast, which needs GCC 11, the copy is compiled to a single move
+    uint64_t bits{};
+    std::memcpy(&bits, &normalized, sizeof(bits));
+    uint64_t constexpr sign_bit = uint64_t{1} << 63;
+
+    return (bits & sign_bit) ? ~bits : (bits | sign_bit);
+}
+
+// the ids [0, keys.size()) sorted by their key, equal keys are ordered by the lower id, so the
+// order is the same on every platform, NaN keys are not supported
+
+// Running time analysis:
+// O(|keys|) with a least significant digit first radix sort of the (key bits, id) pairs, one pass
+// per 11 bit digit of the key, the passes in which all keys share the same digit are skipped
+inline std::vector<size_t> ids_sorted_by_key(std::vector<double> const & keys, bool const descending) {
+    size_t constexpr digit_bits = 11;
+    size_t constexpr num_digits = (64 + digit_bits - 1) / digit_bits;
+    size_t constexpr num_buckets = size_t{1} << digit_bits;
+    uint64_t constexpr digit_mask = num_buckets - 1;
+
+    struct keyed_id {
+        uint64_t key;
+        size_t id;
+    };
+
+    size_t const n = keys.size();
+    std::vector<keyed_id> items(n);
+    std::vector<keyed_id> buffer(n);
+    std::array<std::array<size_t, num_buckets>, num_digits> counts{};
+
+    for (size_t id = 0; id < n; ++id) {
+        uint64_t const key = descending ? ~ordered_bits(keys[id]) : ordered_bits(keys[id]);
+        items[id] = {key, id};
+
+        for (size_t digit = 0; digit < num_digits; ++digit) {
+            ++counts[digit][(key >> (digit_bits * digit)) & digit_mask];
+        }
+    }
+
+    // every pass is stable and the items start in the order of their ids, which breaks the ties
+    for (size_t digit = 0; digit < num_digits; ++digit) {
+        std::array<size_t, num_buckets> & offsets = counts[digit];
+
+        if (n == 0 || offsets[(items.front().key >> (digit_bits * digit)) & digit_mask] == n) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (size_t & count : offsets) {
+            offset += std::exchange(count, offset);
+        }
+
+        for (keyed_id const & item : items) {
+            buffer[offsets[(item.key >> (digit_bits * digit)) & digit_mask]++] = item;
+        }
+
+        items.swap(buffer);
+    }
+
+    std::vector<size_t> ids(n);
+    for (size_t i = 0; i < n; ++i) {
+        ids[i] = items[i].id;
+    }
+
+    return ids;
+}
+
+} // namespace util
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// nested spans of the scheduler internals that are written as Chrome trace-event json, which can be
+// opened in Perfetto or chrome://tracing, the spans are only compiled in with the definition
+// STATIC_TASK_SCHEDULING_TRACE, otherwise all macros expand to nothing
+
+namespace util::trace {
+
+size_t constexpr no_task = std::numeric_limits<size_t>::max();
+
+#ifdef STATIC_TASK_SCHEDULING_TRACE
+bool constexpr compiled_in = true;
+#else
+bool constexpr compiled_in = false;
+#endif
+
+// the names are string literals, so recording an event never allocates a string
+struct event {
+    char const * category;
+    char const * name;
+    int64_t start_ns;
+    int64_t end_ns;
+    size_t task_id;
+};
+
+// every thread appends to its own buffer without any synchronization, only the registration
+// of a new thread and the final dump take the lock, the dump expects that all spans have ended
+class recorder {
+    struct thread_buffer {
+        size_t thread_index;
+        std::vector<event> events{};
+    };
+
+    std::atomic<bool> enabled{false};
+    std::atomic<bool> with_tasks{false};
+    std::chrono::steady_clock::time_point const origin{std::chrono::steady_clock::now()};
+
+    std::mutex buffers_mutex{};
+    std::vector<std::unique_ptr<thread_buffer>> buffers{};
+
+    recorder() = default;
+
+public:
+    static recorder & instance() {
+        static recorder r{};
+        return r;
+    }
+
+    void enable(bool const tasks) {
+        with_tasks.store(tasks, std::memory_order_relaxed);
+        enabled.store(true, std::memory_order_relaxed);
+    }
+
+    void disable() {
+        enabled.store(false, std::memory_order_relaxed);
+    }
+
+    bool is_enabled() const {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    bool records_tasks() const {
+        return with_tasks.load(std::memory_order_relaxed);
+    }
+
+    int64_t now_ns() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - origin
+        ).count();
+    }
+
+    void record(event const & e) {
+        thread_local thread_buffer * const buffer = register_thread();
+        buffer->events.push_back(e);
+    }
+
+    // complete events ("ph":"X") with microsecond timestamps, one track per thread
+    void write_json(std::ostream & out) {
+        std::lock_guard<std::mutex> const lock(buffers_mutex);
+
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+            << "\"args\":{\"name\":\"static_task_scheduling\"}}";
+
+        for (auto const & buffer : buffers) {
+            for (event const & e : buffer->events) {
+                out << ",\n{\"name\":\"" << e.name << "\",\"cat\":\"" << e.category
+                    << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->thread_index
+                    << ",\"ts\":" << static_cast<double>(e.start_ns) / 1000.0
+                    << ",\"dur\":" << static_cast<double>(e.end_ns - e.start_ns) / 1000.0;
+
+                if (e.task_id != no_task) {
+                    out << ",\"args\":{\"task_id\":" << e.task_id << '}';
+                }
+
+                out << '}';
+            }
+        }
+
+        out << "\n]}\n";
+    }
+
+private:
+    thread_buffer * register_thread() {
+        std::lock_guard<std::mutex> const lock(buffers_mutex);
+        buffers.push_back(std::make_unique<thread_buffer>(buffers.size()));
+        return buffers.back().get();
+    }
+};
+
+class span {
+    char const * category;
+    char const * name;
+    size_t task_id;
+    bool active;
+    int64_t start_ns;
+
+public:
+    span(char const * const category_, char const * const name_, size_t const task_id_ = no_task)
+        : category{category_},
+        name{name_},
+        task_id{task_id_},
+        active{
+            recorder::instance().is_enabled()
+            && (task_id_ == no_task || recorder::instance().records_tasks())
+        },
+        start_ns{active ? recorder::instance().now_ns() : 0} {}
+
+    span(span const &) = delete;
+    span & operator=(span const &) = delete;
+
+    ~span() {
+        if (active) {
+            recorder & r = recorder::instance();
+            r.record({category, name, start_ns, r.now_ns(), task_id});
+        }
+    }
+};
+
+// consecutive phases of one algorithm, starting a phase ends the previous one
+class phase_sequence {
+    char const * current_name{nullptr};
+    int64_t start_ns{0};
+
+public:
+    phase_sequence() = default;
+    phase_sequence(phase_sequence const &) = delete;
+    phase_sequence & operator=(phase_sequence const &) = delete;
+
+    void next(char const * const name) {
+        recorder & r = recorder::instance();
+        int64_t const now = r.now_ns();
+
+        if (current_name) {
+            r.record({"phase", current_name, start_ns, now, no_task});
+        }
+
+        current_name = r.is_enabled() ? name : nullptr;
+        start_ns = now;
+    }
+
+    ~phase_sequence() {
+        if (current_name) {
+            recorder & r = recorder::instance();
+            r.record({"phase", current_name, start_ns, r.now_ns(), no_task});
+        }
+    }
+};
+
+// records from its construction on and writes the trace to the file at its destruction,
+// does nothing if the path is empty
+class session {
+    std::string path;
+
+public:
+    session(std::string path_, bool const with_tasks) : path{std::move(path_)} {
+        if (!path.empty()) {
+            recorder::instance().enable(with_tasks);
+        }
+    }
+
+    session(session const &) = delete;
+    session & operator=(session const &) = delete;
+
+    ~session() {
+        if (path.empty()) {
+            return;
+        }
+
+        recorder::instance().disable();
+        std::ofstream out(path, std::ios::trunc);
+        recorder::instance().write_json(out);
+    }
+};
+
+} // namespace util::trace
+
+#ifdef STATIC_TASK_SCHEDULING_TRACE
+
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+
+// a span from here to the end of the enclosing scope
+#define TRACE_SPAN(category, name) \
+    util::trace::span const TRACE_CONCAT(trace_span_, __LINE__)(category, name)
+
+// only recorded if the per task spans are requested, the enclosing scope is usually a loop body
+#define TRACE_TASK_SPAN(name, t_id) \
+    util::trace::span const TRACE_CONCAT(trace_span_, __LINE__)("task", name, t_id)
+
+// a span for the whole function together with the phases inside of it
+#define TRACE_ALGORITHM(name) \
+    TRACE_SPAN("algorithm", name); \
+    util::trace::phase_sequence trace_phases{}
+
+#define TRACE_PHASE(name) trace_phases.next(name)
+
+#else
+
+#define TRACE_SPAN(category, name) static_cast<void>(0)
+#define TRACE_TASK_SPAN(name, t_id) static_cast<void>(0)
+#define TRACE_ALGORITHM(name) static_cast<void>(0)
+#define TRACE_PHASE(name) static_cast<void>(0)
+
+#endif
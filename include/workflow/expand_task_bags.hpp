@@ -11,7 +11,7 @@ namespace workflow {
 
 using unpacked_task_bags = std::tuple<std::vector<task>, std::vector<double>, std::vector<double>>;
 
-unpacked_task_bags expand_task_bags(std::vector<task_bag> const & bags) {
+inline unpacked_task_bags expand_task_bags(std::vector<task_bag> const & bags) {
     std::vector<task> tasks;
     std::vector<double> input_data_sizes;
     std::vector<double> output_data_sizes;
@@ -32,7 +32,7 @@ unpacked_task_bags expand_task_bags(std::vector<task_bag> const & bags) {
 }
 
 // index of the returned vector is to task bag id to which the ids at that index belong
-std::vector<std::vector<task_id>> expand_task_bags_into_ids(std::vector<task_bag> const & bags) {
+inline std::vector<std::vector<task_id>> expand_task_bags_into_ids(std::vector<task_bag> const & bags) {
     std::vector<std::vector<task_id>> ids(bags.size());
 
     task_id first_id{0};
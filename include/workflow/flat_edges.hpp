@@ -0,0 +1,67 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <workflow/task.hpp>
+#include <workflow/workflow.hpp>
+
+namespace workflow {
+
+// the incoming or outgoing edges of all tasks in flat arrays (compressed sparse rows) for hot
+// loops that can't afford hash lookups, the edges of task t are at [offsets[t], offsets[t + 1])
+// and sorted by the id of the other task such that iterating them is deterministic
+struct flat_edges {
+    std::vector<size_t> offsets{};
+    std::vector<task_id> neighbor_ids{};
+    std::vector<double> data_transfers{};
+
+    size_t begin(task_id const t_id) const {
+        return offsets[t_id];
+    }
+
+    size_t end(task_id const t_id) const {
+        return offsets[t_id + 1];
+    }
+};
+
+template <typename F>
+flat_edges flatten_edges(workflow const & w, F const & get_edges) {
+    flat_edges result{};
+    result.offsets.reserve(w.size() + 1);
+    result.offsets.push_back(0);
+
+    std::vector<std::pair<task_id, double>> edges{};
+
+    for (task_id t_id = 0; t_id < w.size(); ++t_id) {
+        std::unordered_map<task_id, double> const & edge_map = get_edges(t_id);
+        edges.assign(edge_map.begin(), edge_map.end());
+        std::ranges::sort(edges);
+
+        for (auto const & [neighbor_id, data_transfer] : edges) {
+            result.neighbor_ids.push_back(neighbor_id);
+            result.data_transfers.push_back(data_transfer);
+        }
+
+        result.offsets.push_back(result.neighbor_ids.size());
+    }
+
+    return result;
+}
+
+inline flat_edges flatten_incoming_edges(workflow const & w) {
+    return flatten_edges(w, [&w] (task_id const t_id) -> auto const & {
+        return w.get_task_incoming_edges(t_id);
+    });
+}
+
+inline flat_edges flatten_outgoing_edges(workflow const & w) {
+    return flatten_edges(w, [&w] (task_id const t_id) -> auto const & {
+        return w.get_task_outgoing_edges(t_id);
+    });
+}
+
+} // namespace workflow
@@ -8,7 +8,8 @@ using task_id = size_t;
 
 struct task {
     task_id const id;
-    double const workload;
+    // not const such that refined estimates can be applied to an existing workflow
+    double workload;
     double const memory_requirement;
 };
 
@@ -34,7 +34,7 @@ enum class bag_dependency {
 using dependency_pattern = std::unordered_map<task_bag_id, 
                             std::unordered_map<task_bag_id, bag_dependency>>;
 
-dependency_pattern to_dependency_pattern(topology const top) {
+inline dependency_pattern to_dependency_pattern(topology const top) {
     switch (top) {
         case topology::epigenome:
             return {
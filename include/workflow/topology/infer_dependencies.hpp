@@ -10,7 +10,7 @@
 
 namespace workflow::topology {
 
-void expand_one_to_one_dependency(
+inline void expand_one_to_one_dependency(
     std::vector<task_dependency> & task_dependencies,
     std::vector<task_id> const & source_bag_task_ids,
     std::vector<task_id> const & target_bag_task_ids
@@ -20,7 +20,7 @@ void expand_one_to_one_dependency(
     }
 }
 
-void expand_distribute_dependency(
+inline void expand_distribute_dependency(
     std::vector<task_dependency> & task_dependencies,
     std::vector<task_id> const & source_bag_task_ids,
     std::vector<task_id> const & target_bag_task_ids
@@ -47,7 +47,7 @@ void expand_distribute_dependency(
     }
 }
 
-void expand_aggregate_dependency(
+inline void expand_aggregate_dependency(
     std::vector<task_dependency> & task_dependencies,
     std::vector<task_id> const & source_bag_task_ids,
     std::vector<task_id> const & target_bag_task_ids
@@ -74,7 +74,7 @@ void expand_aggregate_dependency(
     }
 }
 
-void expand_bag_dependency(
+inline void expand_bag_dependency(
     bag_dependency bag_dep,
     std::vector<task_dependency> & task_dependencies,
     std::vector<task_id> const & source_bag_task_ids,
@@ -130,7 +130,7 @@ void expand_bag_dependency(
     }
 }
 
-std::vector<task_dependency> infer_dependencies(
+inline std::vector<task_dependency> infer_dependencies(
     topology const top, 
     std::vector<task_bag> const & bags,
     std::vector<std::vector<task_id>> const & task_ids_per_bag
@@ -10,7 +10,7 @@
 
 namespace workflow::topology {
 
-void remove_bag_dependencies(
+inline void remove_bag_dependencies(
     std::vector<task_dependency> & task_dependencies,
     task_bag_id const source_bag_id,
     task_bag_id const target_bag_id,
@@ -9,7 +9,7 @@ enum class topology {
     epigenome, cybershake, ligo, montage, none
 };
 
-topology from_string(std::string const & s) {
+inline topology from_string(std::string const & s) {
     if (s == "epigenome") {
         return topology::epigenome;
     } else if (s == "cybershake") {
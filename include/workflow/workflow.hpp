@@ -2,32 +2,66 @@
 
 #include <algorithm>
 #include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <ranges>
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <tuple>
 #include <vector>
 
+#include <cluster/cluster.hpp>
+#include <cluster/cost_model.hpp>
 #include <util/di_graph.hpp>
+#include <util/parallel_for.hpp>
 #include <util/timepoint.hpp>
-#include <workflow/data_transfer_cost.hpp>
 #include <workflow/node_task_matrix.hpp>
 #include <workflow/task.hpp>
 #include <workflow/task_dependency.hpp>
 
 namespace workflow {
 
+task_id constexpr no_task = std::numeric_limits<task_id>::max();
+
+// the rank of every task together with the neighbor that determines it, i.e. the successor that
+// maximizes an upward rank or the predecessor that maximizes a downward rank, no_task if there
+// is no such neighbor, ties are broken by the lower id
+struct task_ranks {
+    std::vector<double> ranks;
+    std::vector<task_id> rank_neighbors;
+};
+
 class workflow {
 public:
     using iterator = util::di_graph<task, double>::vertex_iterator;
 
 private:
     util::di_graph<task, double> g;
-    std::vector<task_id> topological_task_order;
+    std::vector<task_id> topological_task_order; // sorted by (level, id)
     std::vector<size_t> topological_task_ranks; // inverse of topological_task_order
+    std::vector<size_t> topological_task_levels;
+    std::vector<size_t> topological_level_offsets;
     std::unordered_set<task_id> independent_task_ids;
-    std::vector<std::vector<task_id>> const task_ids_per_bag;
+    std::vector<std::vector<task_id>> task_ids_per_bag;
+    // appended tasks are only at the end of the topological order and not in their level yet
+    bool topological_levels_outdated{false};
+
+    // ranks only depend on the workflow, the direction, the performance and the bandwidth, so
+    // repeated runs on the same workflow (e.g. several algorithms or requests to the daemon) reuse
+    // them, a changed workflow gets a new cache, so copies never see ranks of another workflow,
+    // entries are never removed from a cache, so references to them stay valid until the
+    // workflow is changed or destroyed
+    struct rank_cache {
+        std::mutex mutex{};
+        // (upward, performance, bandwidth) -> ranks
+        std::map<std::tuple<bool, double, double>, task_ranks> ranks{};
+    };
+
+    std::shared_ptr<rank_cache> cached_ranks{std::make_shared<rank_cache>()};
 
 public:
     // create a DAG workflow represetation based on the input specifications
@@ -78,61 +112,190 @@ public:
         }
 
         independent_task_ids = g.get_independent_vertex_ids();
-        
-        topological_task_order = g.topological_order().value();
-        for (size_t const i : std::ranges::iota_view{0ul, size()}) {
-            topological_task_ranks.at(topological_task_order.at(i)) = i;
+        compute_topological_order();
+    }
+
+    // for refined runtime estimates, the dependencies and the topological order stay the same
+    void update_task_workload(task_id const t_id, double const workload) {
+        if (workload <= 0) {
+            throw std::invalid_argument("All tasks need a workload > 0");
+        }
+
+        g.get_vertex(t_id).workload = workload;
+        cached_ranks = std::make_shared<rank_cache>();
+    }
+
+    // the topological order is only recomputed if the levels of the tasks change
+    void add_dependency(task_dependency const dep, double const data_transfer) {
+        if (dep.from_id >= size() || dep.to_id >= size()) {
+            throw std::invalid_argument("Task ids for dependency endpoints are invalid.");
+        }
+
+        size_t const from_level = topological_task_levels[dep.from_id];
+        size_t const to_level = topological_task_levels[dep.to_id];
+
+        if (from_level >= to_level && depends_on(dep.from_id, dep.to_id)) {
+            throw std::invalid_argument("The new dependency would create a cycle.");
+        }
+
+        if (!g.add_edge(dep.from_id, dep.to_id, data_transfer)) {
+            throw std::invalid_argument("The dependency already exists.");
+        }
+
+        independent_task_ids.erase(dep.to_id);
+        cached_ranks = std::make_shared<rank_cache>();
+
+        if (from_level >= to_level) {
+            compute_topological_order();
         }
     }
 
+    // appends a bag of tasks that only depend on already existing tasks, the topological order
+    // stays valid when the new tasks are appended to it, only the grouping of the order into levels
+    // is deferred to update_topological_levels, so the running time doesn't depend on the size of
+    // the workflow, data_transfers[i] is the weight of dependencies[i]
+    void append_task_bag(
+        std::vector<task> const & tasks,
+        std::vector<task_dependency> const & dependencies,
+        std::vector<double> const & data_transfers
+    ) {
+        if (dependencies.size() != data_transfers.size()) {
+            throw std::invalid_argument("Arguments for dependency parameters must have the same size.");
+        }
+
+        task_id const first_new_id = size();
+        std::vector<task_id> bag_task_ids{};
+
+        for (task const & t : tasks) {
+            if (t.id != size()) {
+                throw std::invalid_argument("The ids of appended tasks must continue the existing ids.");
+            }
+
+            if (t.workload <= 0) {
+                throw std::invalid_argument("All tasks need a workload > 0");
+            }
+
+            g.add_vertex(t);
+            bag_task_ids.push_back(t.id);
+            independent_task_ids.insert(t.id);
+
+            topological_task_ranks.push_back(topological_task_order.size());
+            topological_task_order.push_back(t.id);
+            topological_task_levels.push_back(0);
+        }
+
+        for (size_t i = 0; i < dependencies.size(); ++i) {
+            task_dependency const & dep = dependencies[i];
+
+            if (dep.from_id >= first_new_id || dep.to_id < first_new_id || dep.to_id >= size()) {
+                throw std::invalid_argument("Appended dependencies must lead from existing to new tasks.");
+            }
+
+            if (!g.add_edge(dep.from_id, dep.to_id, data_transfers[i])) {
+                throw std::invalid_argument("The dependency already exists.");
+            }
+
+            independent_task_ids.erase(dep.to_id);
+            topological_task_levels[dep.to_id] = std::max(
+                topological_task_levels[dep.to_id],
+                topological_task_levels[dep.from_id] + 1
+            );
+        }
+
+        task_ids_per_bag.push_back(std::move(bag_task_ids));
+        cached_ranks = std::make_shared<rank_cache>();
+
+        if (!tasks.empty()) {
+            topological_levels_outdated = true;
+        }
+    }
+
+    // restores the (level, id) order of the topological order after tasks were appended
+    void update_topological_levels() {
+        if (topological_levels_outdated) {
+            compute_topological_order();
+        }
+    }
+
+    // whether there is a path from dependency_id to t_id, only tasks in lower levels are visited
+    bool depends_on(task_id const t_id, task_id const dependency_id) const {
+        if (t_id == dependency_id) {
+            return true;
+        }
+
+        size_t const max_level = topological_task_levels[t_id];
+        std::vector<task_id> stack{dependency_id};
+        std::unordered_set<task_id> visited{dependency_id};
+
+        while (!stack.empty()) {
+            task_id const curr_id = stack.back();
+            stack.pop_back();
+
+            for (auto const & [succ_id, data_transfer] : g.get_outgoing_edges(curr_id)) {
+                if (succ_id == t_id) {
+                    return true;
+                }
+
+                if (topological_task_levels[succ_id] < max_level && visited.insert(succ_id).second) {
+                    stack.push_back(succ_id);
+                }
+            }
+        }
+
+        return false;
+    }
+
     // performance and bandwidth are mean values for HEFT/CPOP
     // and uniform/best for TDCA
-    std::unordered_map<task_id, double> all_downward_ranks(
+    // task id -> downward rank, computed level by level with the tasks of a level in parallel,
+    // the ranks are cached and stay valid until the workflow is changed
+    std::vector<double> const & all_downward_ranks(
         double const performance,
         double const bandwidth
     ) const {
-        std::unordered_map<task_id, double> downward_ranks{};
-        
-        for (task_id const t_id : topological_task_order) {
-            double const downward_rank = compute_downward_rank(
-                downward_ranks, 
-                performance, 
-                bandwidth, 
-                t_id
-            );
-            downward_ranks.insert({t_id, downward_rank});
-        }
+        return all_downward_ranks_and_predecessors(performance, bandwidth).ranks;
+    }
 
-        return downward_ranks;
+    // the downward ranks together with the predecessor of every task on its longest path
+    // from an entry task
+    task_ranks const & all_downward_ranks_and_predecessors(
+        double const performance,
+        double const bandwidth
+    ) const {
+        return get_or_compute_ranks(false, performance, bandwidth, [&] () {
+            return compute_all_downward_ranks(performance, bandwidth);
+        });
     }
 
     // performance and bandwidth are mean values for HEFT/CPOP
     // and uniform/best for TDCA
-    std::unordered_map<task_id, double> all_upward_ranks(
+    // task id -> upward rank, computed level by level with the tasks of a level in parallel,
+    // the ranks are cached and stay valid until the workflow is changed
+    std::vector<double> const & all_upward_ranks(
         double const performance,
         double const bandwidth
     ) const {
-        std::unordered_map<task_id, double> upward_ranks{};
-        
-        for (task_id const t_id : std::views::reverse(topological_task_order)) {
-            double const upward_rank = compute_upward_rank(
-                upward_ranks, 
-                performance, 
-                bandwidth, 
-                t_id
-            );
-            upward_ranks.insert({t_id, upward_rank});
-        }
+        return all_upward_ranks_and_successors(performance, bandwidth).ranks;
+    }
 
-        return upward_ranks;
+    // the upward ranks together with the successor of every task on its longest path
+    // to an exit task
+    task_ranks const & all_upward_ranks_and_successors(
+        double const performance,
+        double const bandwidth
+    ) const {
+        return get_or_compute_ranks(true, performance, bandwidth, [&] () {
+            return compute_all_upward_ranks(performance, bandwidth);
+        });
     }
 
+    template <cluster::cost_model M>
     std::tuple<
         node_task_matrix<util::timepoint>, 
         node_task_matrix<util::timepoint>,
         std::vector<task_id>
     > // return: (est, eft, cpred)
-    compute_est_and_eft(cluster::cluster const & c) const {
+    compute_est_and_eft(cluster::cluster const & c, M const & model) const {
         using util::timepoint;
         std::vector<std::vector<timepoint>> est_data(c.size(), std::vector<timepoint>(size()));
         std::vector<std::vector<timepoint>> eft_data(c.size(), std::vector<timepoint>(size()));
@@ -140,32 +303,30 @@ public:
         std::vector<task_id> cpred(size());
         cluster::node_id const best_node_id = c.best_performance_node();
 
-        for (task_id const & t_id : topological_task_order) {
+        for_each_task_level_parallel(false, min_est_eft_tasks_per_thread, [&] (task_id const t_id) {
             for (cluster::cluster_node const & node : c) {
                 auto & curr_est = est_data.at(node.id).at(t_id);
                 auto & curr_eft = eft_data.at(node.id).at(t_id);
 
                 auto incoming_efts = get_task_incoming_edges(t_id)
-                    | std::views::transform([&c, &eft_data, best_node_id, node] (auto const & edge) {
+                    | std::views::transform([&model, &eft_data, best_node_id, node] (auto const & edge) {
                         auto const & [neighbor_id, data_transfer] = edge;
 
                         // since in our model the node performances simple scale the task workloads,
                         // the node with the best eft will always be the one with the best performance
                         timepoint const pred_eft_best = eft_data.at(best_node_id).at(neighbor_id);
-                        timepoint const data_transfer_cost_best = get_data_transfer_cost(
-                            best_node_id,
-                            node.id,
+                        timepoint const data_transfer_cost_best = model.data_transfer_cost(
                             data_transfer,
-                            c.uniform_bandwidth()
+                            best_node_id,
+                            node.id
                         );
 
                         // the next est could still be improved by keeping the tasks on the same node
                         timepoint const pred_eft_same = eft_data.at(node.id).at(neighbor_id);
-                        timepoint const data_transfer_cost_same = get_data_transfer_cost(
-                            node.id,
-                            node.id,
+                        timepoint const data_transfer_cost_same = model.data_transfer_cost(
                             data_transfer,
-                            c.uniform_bandwidth()
+                            node.id,
+                            node.id
                         );
 
                         timepoint const best_incoming_eft = std::min(
@@ -193,13 +354,13 @@ public:
                     : *max_it;
 
                 curr_est = max_incoming_eft;
-                curr_eft = curr_est + get_task(t_id).workload / node.performance();
+                curr_eft = curr_est + model.computation_time(get_task(t_id).workload, node.id);
 
                 if (node.id == best_node_id) {
                     cpred.at(t_id) = cpred_id;
                 }
             }
-        }
+        });
 
         return std::make_tuple(
             node_task_matrix(std::move(est_data)),
@@ -260,6 +421,32 @@ public:
         return topological_task_ranks.at(t_id);
     }
 
+    // length of the longest path from an independent task to this task
+    size_t topological_task_level(task_id const t_id) const {
+        return topological_task_levels.at(t_id);
+    }
+
+    size_t num_topological_levels() const {
+        throw_if_topological_levels_outdated();
+        return topological_level_offsets.size() - 1;
+    }
+
+    // all tasks of the given level in ascending id order, 
+    // the tasks of one level don't depend on each other
+    std::span<task_id const> get_topological_level(size_t const level) const {
+        throw_if_topological_levels_outdated();
+
+        auto const first = topological_task_order.begin() + topological_level_offsets.at(level);
+        auto const last = topological_task_order.begin() + topological_level_offsets.at(level + 1);
+
+        return std::span<task_id const>(first, last);
+    }
+
+    // task id -> number of direct predecessors
+    std::vector<size_t> get_task_in_degrees() const {
+        return g.in_degrees();
+    }
+
     std::unordered_set<task_id> const & get_independent_task_ids() const {
         return independent_task_ids;
     }
@@ -302,50 +489,191 @@ public:
     }
 
 private:
+    void compute_topological_order() {
+        auto sorting = g.topological_sort();
+
+        if (!sorting) {
+            throw std::invalid_argument("The task dependencies contain a cycle.");
+        }
+
+        topological_task_order = std::move(sorting->order);
+        topological_task_levels = std::move(sorting->levels);
+        topological_level_offsets = std::move(sorting->level_offsets);
+
+        topological_task_ranks.resize(size());
+        for (size_t const i : std::ranges::iota_view{0ul, size()}) {
+            topological_task_ranks.at(topological_task_order.at(i)) = i;
+        }
+
+        topological_levels_outdated = false;
+    }
+
+    void throw_if_topological_levels_outdated() const {
+        if (topological_levels_outdated) {
+            throw std::runtime_error("Internal bug: the topological levels are outdated after appending tasks.");
+        }
+    }
+
+    // thresholds for the wavefront traversal below which a level is processed serially
+    static constexpr size_t min_rank_tasks_per_thread = 4096;
+    static constexpr size_t min_est_eft_tasks_per_thread = 256;
+
+    // wavefront traversal: the levels are processed one after another (optionally from the last
+    // to the first) and all tasks of one level in parallel, which is safe as long as func only
+    // reads results of tasks from earlier levels and only writes results of the given task
+    template <typename F>
+    void for_each_task_level_parallel(
+        bool const reverse_levels,
+        size_t const min_tasks_per_thread,
+        F const & func
+    ) const {
+        size_t const num_levels = num_topological_levels();
+
+        for (size_t i = 0; i < num_levels; ++i) {
+            size_t const level = reverse_levels ? num_levels - 1 - i : i;
+            auto const level_task_ids = get_topological_level(level);
+
+            util::parallel_for(level_task_ids.size(), min_tasks_per_thread, 
+                [&func, &level_task_ids] (size_t const j) {
+                    func(level_task_ids[j]);
+                }
+            );
+        }
+    }
+
+    // the edges are hash maps without a fixed order, so the ties are broken explicitly
+    static void update_rank_neighbor(
+        double const neighbor_rank,
+        task_id const neighbor_id,
+        double & max_neighbor_rank,
+        task_id & rank_neighbor
+    ) {
+        if (
+            rank_neighbor == no_task
+            || neighbor_rank > max_neighbor_rank
+            || (neighbor_rank == max_neighbor_rank && neighbor_id < rank_neighbor)
+        ) {
+            max_neighbor_rank = neighbor_rank;
+            rank_neighbor = neighbor_id;
+        }
+    }
+
     double compute_upward_rank(
-        std::unordered_map<task_id, double> const & upward_ranks,
-        double const performance,
-        double const bandwidth,
-        task_id const t_id
+        std::vector<double> const & upward_ranks,
+        double const inverse_performance,
+        double const inverse_bandwidth,
+        task_id const t_id,
+        task_id & rank_successor
     ) const {
-        double upward_rank = get_task(t_id).workload / performance;
+        double upward_rank = get_task(t_id).workload * inverse_performance;
+        double max_outgoing_rank = 0.0;
+        rank_successor = no_task;
 
-        auto outgoing_ranks = g.get_outgoing_edges(t_id) 
-            | std::views::transform([&upward_ranks, bandwidth] (auto const & edge) {
-                auto const & [neighbor_id, data_transfer] = edge;
-                return data_transfer / bandwidth + upward_ranks.at(neighbor_id);
-            }
-        );
+        for (auto const & [neighbor_id, data_transfer] : g.get_outgoing_edges(t_id)) {
+            double const outgoing_rank = data_transfer * inverse_bandwidth + upward_ranks.at(neighbor_id);
+            update_rank_neighbor(outgoing_rank, neighbor_id, max_outgoing_rank, rank_successor);
+        }
 
-        auto const max_it = std::ranges::max_element(outgoing_ranks);
-        if (max_it != outgoing_ranks.end()) {
-            upward_rank += *max_it;
+        if (rank_successor != no_task) {
+            upward_rank += max_outgoing_rank;
         }
 
         return upward_rank;
     }
 
     double compute_downward_rank(
-        std::unordered_map<task_id, double> const & downward_ranks,
+        std::vector<double> const & downward_ranks,
+        double const inverse_performance,
+        double const inverse_bandwidth,
+        task_id const t_id,
+        task_id & rank_predecessor
+    ) const {
+        double max_incoming_rank = 0.0;
+        rank_predecessor = no_task;
+
+        for (auto const & [neighbor_id, data_transfer] : g.get_incoming_edges(t_id)) {
+            double const neighbor_compute_cost = g.get_vertex(neighbor_id).workload * inverse_performance;
+            double const data_transfer_cost = data_transfer * inverse_bandwidth;
+            double const incoming_rank = neighbor_compute_cost + data_transfer_cost + downward_ranks.at(neighbor_id);
+            update_rank_neighbor(incoming_rank, neighbor_id, max_incoming_rank, rank_predecessor);
+        }
+
+        return max_incoming_rank;
+    }
+
+    template <typename F>
+    task_ranks const & get_or_compute_ranks(
+        bool const upward,
         double const performance,
         double const bandwidth,
-        task_id const t_id
+        F const & compute
+    ) const {
+        std::shared_ptr<rank_cache> const cache = cached_ranks;
+        auto const key = std::make_tuple(upward, performance, bandwidth);
+
+        {
+            std::lock_guard<std::mutex> const lock(cache->mutex);
+            auto const it = cache->ranks.find(key);
+
+            if (it != cache->ranks.end()) {
+                return it->second;
+            }
+        }
+
+        // computed without the lock, concurrent callers at worst compute the same ranks twice
+        task_ranks ranks = compute();
+
+        std::lock_guard<std::mutex> const lock(cache->mutex);
+        // a concurrent caller may have inserted the same ranks in the meantime
+        auto const [it, inserted] = cache->ranks.try_emplace(key, std::move(ranks));
+
+        return it->second;
+    }
+
+    task_ranks compute_all_downward_ranks(
+        double const performance,
+        double const bandwidth
     ) const {
-        auto incoming_ranks = g.get_incoming_edges(t_id) 
-            | std::views::transform([this, &downward_ranks, performance, bandwidth] (auto const & edge) {
-                auto const & [neighbor_id, data_transfer] = edge;
-                double const neighbor_compute_cost = g.get_vertex(neighbor_id).workload / performance;
-                double const data_transfer_cost = data_transfer / bandwidth;
-                return  neighbor_compute_cost + data_transfer_cost + downward_ranks.at(neighbor_id);
+        task_ranks downward_ranks{std::vector<double>(size()), std::vector<task_id>(size())};
+        double const inverse_performance = 1.0 / performance;
+        double const inverse_bandwidth = 1.0 / bandwidth;
+
+        for_each_task_level_parallel(false, min_rank_tasks_per_thread, 
+            [&] (task_id const t_id) {
+                downward_ranks.ranks[t_id] = compute_downward_rank(
+                    downward_ranks.ranks, 
+                    inverse_performance, 
+                    inverse_bandwidth, 
+                    t_id,
+                    downward_ranks.rank_neighbors[t_id]
+                );
             }
         );
 
-        auto const max_it = std::ranges::max_element(incoming_ranks);
-        if (max_it == incoming_ranks.end()) {
-            return 0.0;
-        }
+        return downward_ranks;
+    }
 
-        return *max_it;
+    task_ranks compute_all_upward_ranks(
+        double const performance,
+        double const bandwidth
+    ) const {
+        task_ranks upward_ranks{std::vector<double>(size()), std::vector<task_id>(size())};
+        double const inverse_performance = 1.0 / performance;
+        double const inverse_bandwidth = 1.0 / bandwidth;
+
+        for_each_task_level_parallel(true, min_rank_tasks_per_thread, 
+            [&] (task_id const t_id) {
+                upward_ranks.ranks[t_id] = compute_upward_rank(
+                    upward_ranks.ranks, 
+                    inverse_performance, 
+                    inverse_bandwidth, 
+                    t_id,
+                    upward_ranks.rank_neighbors[t_id]
+                );
+            }
+        );
+
+        return upward_ranks;
     }
 };
 
@@ -0,0 +1,205 @@
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <algorithms/algorithm.hpp>
+#include <algorithms/daemon.hpp>
+#include <algorithms/handle_execution.hpp>
+#include <algorithms/multi_workflow.hpp>
+#include <algorithms/online.hpp>
+#include <algorithms/portfolio.hpp>
+#include <cluster/cluster.hpp>
+#include <cluster/core_model.hpp>
+#include <cluster/cost_model.hpp>
+#include <io/export_schedule.hpp>
+#include <io/handle_output.hpp>
+#include <io/issue_warning.hpp>
+#include <io/parse_command_line.hpp>
+#include <io/parse_schedule_delta.hpp>
+#include <io/read_cluster_input.hpp>
+#include <io/read_workflow_input.hpp>
+#include <schedule/from_assignment.hpp>
+#include <scheduling/command_line.hpp>
+#include <util/trace.hpp>
+#include <workflow/workflow.hpp>
+
+namespace scheduling {
+
+int run_command_line(int argc, char * argv[]) {
+    auto const args_option = io::parse_command_line(argc, argv);
+
+    if (!args_option) {
+        return -1;
+    }
+
+    auto const args = args_option.value();
+
+    if (!args.output.empty()) {
+        // truncate output file
+        std::ofstream(args.output, std::ios::trunc);
+    }
+
+    if (!args.trace_output.empty() && !util::trace::compiled_in) {
+        io::issue_warning(args, "Tracing is not compiled in, build with -DENABLE_TRACING=ON to record a trace.");
+    }
+
+    // the trace is written when the session ends at the return from this function
+    util::trace::session const trace_session(
+        util::trace::compiled_in ? args.trace_output : std::string{},
+        args.trace_tasks
+    );
+    TRACE_SPAN("run", "static_task_scheduling");
+
+    if (args.portfolio && !args.select_algorithm.empty()) {
+        throw std::runtime_error("The portfolio mode can't be combined with selecting an algorithm.");
+    }
+
+    // fail early on an invalid export format instead of after the first algorithm
+    io::export_format_from_string(args.export_format);
+
+    if (!args.analytics_format.empty() && args.analytics_format != "summary" && args.analytics_format != "json") {
+        throw std::runtime_error("The analytics format must be summary or json.");
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+
+    std::optional<cluster::core_model> cores{};
+    if (args.core_model) {
+        if (args.parallel_fraction < 0.0 || args.parallel_fraction > 1.0) {
+            throw std::runtime_error("The parallel fraction must be between 0 and 1.");
+        }
+
+        if (args.min_efficiency < 0.0 || args.min_efficiency > 1.0) {
+            throw std::runtime_error("The minimum parallel efficiency must be between 0 and 1.");
+        }
+
+        cores = cluster::core_model{args.parallel_fraction, args.max_cores_per_task, args.min_efficiency};
+    }
+
+    cluster::cluster const c = io::read_cluster_input(
+        args.cluster_input,
+        args.rack_input,
+        args.link_input,
+        cores
+    );
+
+    if (args.fail_node && args.failed_node_id >= c.size()) {
+        throw std::runtime_error("The failed node id is not part of the cluster.");
+    }
+
+    if (args.fail_node && c.size() == 1) {
+        throw std::runtime_error("The only node of the cluster can't fail, no node would be left for its tasks.");
+    }
+
+    if (args.daemon) {
+        if (
+            !args.task_bag_input.empty() || !args.workflow_list_input.empty() || args.portfolio 
+            || args.online || !args.select_algorithm.empty() || !args.task_to_node_assignment_input.empty()
+        ) {
+            throw std::runtime_error(
+                "The daemon can't be combined with a tasks file, a workflow list, selecting an "
+                "algorithm, the portfolio mode, the online mode or an assignment file."
+            );
+        }
+
+        algorithms::handle_daemon_execution(args, c, cores);
+        return 0;
+    }
+
+    if (!args.workflow_list_input.empty()) {
+        if (args.portfolio || args.online || !args.select_algorithm.empty() 
+            || !args.task_to_node_assignment_input.empty()) {
+            throw std::runtime_error(
+                "A workflow list can't be combined with selecting an algorithm, "
+                "the portfolio mode, the online mode or an assignment file."
+            );
+        }
+
+        io::handle_output_obj<cluster::cluster>(args, c);
+        algorithms::handle_multi_workflow_execution(args, c);
+        return 0;
+    }
+
+    if (args.online) {
+        if (args.portfolio || !args.select_algorithm.empty() || !args.task_to_node_assignment_input.empty()) {
+            throw std::runtime_error(
+                "The online mode can't be combined with selecting an algorithm, "
+                "the portfolio mode or an assignment file."
+            );
+        }
+
+        algorithms::handle_online_execution(args, c);
+        return 0;
+    }
+
+    io::handle_output_obj<cluster::cluster>(args, c);
+
+    io::workflow_input input = io::read_workflow_input(
+        args.task_bag_input,
+        args.topology,
+        args.dependency_input
+    );
+
+    workflow::workflow const w(
+        std::move(input.tasks), 
+        std::move(input.input_data_sizes), 
+        std::move(input.output_data_sizes), 
+        std::move(input.dependencies), 
+        std::move(input.task_ids_per_bag)
+    );
+
+    // invalid changes fail before any schedule is computed
+    if (io::has_schedule_delta(args)) {
+        io::parse_schedule_delta(args, w.size());
+    }
+
+    io::handle_output_obj(args, w, c.best_performance());
+
+    if (args.portfolio) {
+        algorithms::handle_portfolio_execution(args, c, w);
+    } else if (args.select_algorithm.empty()) {
+        for (auto const & algo : algorithms::ALL) {
+            algorithms::handle_execution(algo, args, c, w);
+        }
+    } else {
+        auto const algo_opt = algorithms::from_string(args.select_algorithm);
+        if (algo_opt) {
+            algorithms::handle_execution(algo_opt.value(), args, c, w);
+        }
+    }
+
+    if (!args.task_to_node_assignment_input.empty()) {
+        auto const task_to_node_assignment = io::read_task_to_node_assignment_csv(
+            args.task_to_node_assignment_input, 
+            w.size(), 
+            c.size()
+        );
+
+        cluster::visit_cost_model(c, [&] <cluster::cost_model M> ([[maybe_unused]] M const & model) {
+            auto const sched = schedule::from_assignment<M>(
+                task_to_node_assignment,
+                c,
+                w, 
+                args.use_memory_requirements
+            );
+
+            io::handle_computed_schedule_output(
+                "FROM_FILE",
+                "not measured",
+                args,
+                sched,
+                w
+            );
+
+            algorithms::handle_improvement("FROM_FILE", args, c, w, sched);
+            algorithms::handle_repair("FROM_FILE", args, w, sched);
+        });
+    }
+
+    return 0;
+}
+
+} // namespace scheduling
@@ -0,0 +1,155 @@
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <algorithms/algorithm.hpp>
+#include <algorithms/algorithm_options.hpp>
+#include <cluster/cluster.hpp>
+#include <cluster/core_model.hpp>
+#include <cluster/cost_model.hpp>
+#include <io/read_cluster_input.hpp>
+#include <io/read_workflow_input.hpp>
+#include <schedule/schedule.hpp>
+#include <scheduling/scheduler_context.hpp>
+#include <workflow/workflow.hpp>
+
+namespace scheduling {
+
+namespace {
+
+cluster::cluster read_cluster(std::string const & cluster_input, cluster_options const & options) {
+    std::optional<cluster::core_model> cores{};
+    if (options.core_model) {
+        if (options.parallel_fraction < 0.0 || options.parallel_fraction > 1.0) {
+            throw std::invalid_argument("The parallel fraction must be between 0 and 1.");
+        }
+
+        if (options.min_efficiency < 0.0 || options.min_efficiency > 1.0) {
+            throw std::invalid_argument("The minimum parallel efficiency must be between 0 and 1.");
+        }
+
+        cores = cluster::core_model{options.parallel_fraction, options.max_cores_per_task, options.min_efficiency};
+    }
+
+    return io::read_cluster_input(cluster_input, options.rack_input, options.link_input, cores);
+}
+
+} // namespace
+
+struct scheduler_context::impl {
+    cluster::cluster c;
+    // the workflows never move, so their cached ranks stay where the algorithms expect them
+    std::vector<std::unique_ptr<workflow::workflow const>> workflows{};
+    // the algorithms never write output
+    algorithms::algorithm_options options{};
+    // the cost model is fixed by the cluster, so only one alternative is ever used, the schedule
+    // is reset by every call and keeps the memory of its intervals
+    std::variant<
+        std::monostate,
+        schedule::schedule<cluster::uniform_cost_model>,
+        schedule::schedule<cluster::node_bandwidth_cost_model>,
+        schedule::schedule<cluster::link_bandwidth_cost_model>
+    > cached_schedule{};
+    schedule_result result{};
+
+    workflow::workflow const & get_workflow(workflow_handle const handle) const {
+        if (handle >= workflows.size()) {
+            throw std::out_of_range("The workflow handle " + std::to_string(handle) + " is unknown.");
+        }
+
+        return *workflows[handle];
+    }
+};
+
+scheduler_context::scheduler_context(std::string const & cluster_input, cluster_options const & options)
+    : pimpl(std::make_unique<impl>(read_cluster(cluster_input, options))) {}
+
+scheduler_context::~scheduler_context() = default;
+
+scheduler_context::scheduler_context(scheduler_context &&) noexcept = default;
+
+scheduler_context & scheduler_context::operator=(scheduler_context &&) noexcept = default;
+
+workflow_handle scheduler_context::load_workflow(
+    std::string const & task_bag_input,
+    std::string const & topology,
+    std::string const & dependency_input
+) {
+    io::workflow_input input = io::read_workflow_input(task_bag_input, topology, dependency_input);
+
+    pimpl->workflows.push_back(std::make_unique<workflow::workflow const>(
+        std::move(input.tasks),
+        std::move(input.input_data_sizes),
+        std::move(input.output_data_sizes),
+        std::move(input.dependencies),
+        std::move(input.task_ids_per_bag)
+    ));
+
+    return pimpl->workflows.size() - 1;
+}
+
+size_t scheduler_context::num_nodes() const {
+    return pimpl->c.size();
+}
+
+size_t scheduler_context::num_tasks(workflow_handle const handle) const {
+    return pimpl->get_workflow(handle).size();
+}
+
+schedule_result const & scheduler_context::schedule(
+    workflow_handle const handle,
+    std::string const & algorithm,
+    scheduler_options const & options
+) {
+    workflow::workflow const & w = pimpl->get_workflow(handle);
+
+    std::optional<algorithms::algorithm> const algo_opt = algorithms::from_string(algorithm);
+    if (!algo_opt) {
+        throw std::invalid_argument("The algorithm " + algorithm + " is unknown.");
+    }
+
+    algorithms::algorithm_options & algo_options = pimpl->options;
+    algo_options.use_memory_requirements = options.use_memory_requirements;
+    algo_options.ga_generations = options.ga_generations;
+    algo_options.ga_time_ms = options.ga_time_ms;
+
+    // clearing keeps the capacity of the placements for the next call
+    schedule_result & result = pimpl->result;
+    result.placements.clear();
+
+    cluster::visit_cost_model(pimpl->c, [&] <cluster::cost_model M> ([[maybe_unused]] M const & model) {
+        if (!std::holds_alternative<schedule::schedule<M>>(pimpl->cached_schedule)) {
+            pimpl->cached_schedule.emplace<schedule::schedule<M>>(pimpl->c, options.use_memory_requirements);
+        }
+
+        schedule::schedule<M> & s = std::get<schedule::schedule<M>>(pimpl->cached_schedule);
+        algorithms::compute_schedule<M>(algo_opt.value(), pimpl->c, w, algo_options, s);
+
+        result.algorithm = algorithms::to_string(algo_opt.value());
+        result.makespan = s.get_makespan();
+        result.valid = !options.validate || s.is_valid(w);
+
+        s.for_each_interval([&result] (
+            workflow::task_id const t_id,
+            schedule::time_interval const & interval,
+            bool const is_duplicate
+        ) {
+            result.placements.push_back({
+                t_id,
+                interval.node_id,
+                interval.start,
+                interval.end,
+                interval.cores,
+                is_duplicate
+            });
+        });
+    });
+
+    return result;
+}
+
+} // namespace scheduling
@@ -23,6 +23,19 @@ $1/static_task_scheduling \
 -d ./data/example_dependencies.csv \
 -s none \
 -a ./data/example_assignment.csv
+echo "-------------------- Illustrative example (csv and binary export) --------------------"
+$1/static_task_scheduling \
+-c ./data/example_cluster.csv \
+-t ./data/example_task_bags.csv \
+-d ./data/example_dependencies.csv \
+-e ./example_schedule
+$1/static_task_scheduling \
+-c ./data/example_cluster.csv \
+-t ./data/example_task_bags.csv \
+-d ./data/example_dependencies.csv \
+-s tdca \
+-e ./example_schedule \
+-f binary
 echo "-------------------- Epigenome small --------------------"
 $1/static_task_scheduling \
 -c ./data/small_cluster.csv \
@@ -33,6 +46,13 @@ $1/static_task_scheduling \
 -c ./data/large_cluster.csv \
 -t ./data/epigenome_2000.csv \
 -p epigenome
+echo "-------------------- Epigenome large (without validation) --------------------"
+$1/static_task_scheduling \
+-c ./data/large_cluster.csv \
+-t ./data/epigenome_2000.csv \
+-p epigenome \
+-s heft \
+--no-validate
 echo "-------------------- CyberShake small --------------------"
 $1/static_task_scheduling \
 -c ./data/small_cluster.csv \
@@ -65,6 +85,135 @@ $1/static_task_scheduling \
 -t ./data/montage_1000.csv \
 -d ./data/montage_1000.xml \
 -p montage
+echo "-------------------- Epigenome large with racks --------------------"
+$1/static_task_scheduling \
+-c ./data/large_cluster.csv \
+-r ./data/large_cluster_racks.csv \
+-t ./data/epigenome_2000.csv \
+-p epigenome
+echo "-------------------- Illustrative example with links --------------------"
+$1/static_task_scheduling \
+-c ./data/example_cluster.csv \
+-l ./data/example_links.csv \
+-t ./data/example_task_bags.csv \
+-d ./data/example_dependencies.csv
+echo "-------------------- Cybershake large portfolio with time budget --------------------"
+$1/static_task_scheduling \
+-c ./data/large_cluster.csv \
+-t ./data/cybershake_2000.csv \
+-p cybershake \
+--portfolio \
+--time-budget 200
+echo "-------------------- Small montage HEFT with local search --------------------"
+$1/static_task_scheduling \
+-c ./data/small_cluster.csv \
+-t ./data/montage_100.csv \
+-d ./data/montage_100.xml \
+-p montage \
+-s heft \
+--improve-iterations 10000
+echo "-------------------- Ligo genetic algorithm with memory requirements --------------------"
+$1/static_task_scheduling \
+-c ./data/large_cluster.csv \
+-t ./data/ligo_2000.csv \
+-p ligo \
+-s genetic \
+--ga-generations 20 \
+-m
+echo "-------------------- Cybershake DBCA with a failed node --------------------"
+$1/static_task_scheduling \
+-c ./data/large_cluster.csv \
+-r ./data/large_cluster_racks.csv \
+-t ./data/cybershake_2000.csv \
+-p cybershake \
+-s dbca \
+--fail-node 0
+echo "-------------------- Epigenome HEFT with updated workloads --------------------"
+$1/static_task_scheduling \
+-c ./data/small_cluster.csv \
+-t ./data/epigenome_100.csv \
+-p epigenome \
+-s heft \
+--update-workload 5:20000 \
+--update-workload 40:1
+echo "-------------------- Ligo CPOP with an added dependency and a failed node --------------------"
+$1/static_task_scheduling \
+-c ./data/large_cluster.csv \
+-t ./data/ligo_2000.csv \
+-p ligo \
+-s cpop \
+--add-dependency 0:1:50 \
+--fail-node 1
+echo "-------------------- Montage with tasks on individual cores --------------------"
+$1/static_task_scheduling \
+-c ./data/large_cluster.csv \
+-t ./data/montage_1000.csv \
+-d ./data/montage_1000.xml \
+-p montage \
+-s cpop \
+--core-model \
+--parallel-fraction 0.5
+echo "-------------------- Montage on up to 64 cores per task with an efficiency limit --------------------"
+$1/static_task_scheduling \
+-c ./data/large_cluster.csv \
+-t ./data/montage_1000.csv \
+-d ./data/montage_1000.xml \
+-p montage \
+-s heft \
+--core-model \
+--parallel-fraction 0.9 \
+--max-cores-per-task 64 \
+--min-efficiency 0.5
+echo "-------------------- Ligo online from a pipe --------------------"
+cat ./data/ligo_100.csv | $1/static_task_scheduling \
+-c ./data/small_cluster.csv \
+-t - \
+-p ligo \
+--online
+echo "-------------------- Example online with dependency lines --------------------"
+$1/static_task_scheduling \
+-c ./data/example_cluster.csv \
+-t ./data/example_online_stream.csv \
+--online
+echo "-------------------- Online with an empty bag --------------------"
+printf 'workload, input_data_size, output_data_size, memory, cardinality\n1000, 10, 20, 1, 1\n500, 20, 40, 1, 0\n400, 40, 50, 1, 2\n' \
+| $1/static_task_scheduling \
+-c ./data/example_cluster.csv \
+-t - \
+--online
+echo "-------------------- Several workflows with release times and priorities --------------------"
+$1/static_task_scheduling \
+-c ./data/small_cluster.csv \
+-w ./data/example_workflows.csv
+echo "-------------------- Daemon requests from the standard input --------------------"
+printf 'id=1 algorithm=heft tasks=./data/ligo_100.csv topology=ligo records=0\nid=2 algorithm=cpop tasks=./data/ligo_100.csv topology=ligo records=0\n' \
+| $1/static_task_scheduling \
+-c ./data/small_cluster.csv \
+--daemon \
+--workers 1
+echo "-------------------- LIGO 100 TDCA timeline export --------------------"
+$1/static_task_scheduling \
+-c ./data/small_cluster.csv \
+-t ./data/ligo_100.csv \
+-p ligo \
+-s tdca \
+-e example_schedule \
+-f trace
+echo "-------------------- LIGO 100 schedule analytics --------------------"
+$1/static_task_scheduling \
+-c ./data/small_cluster.csv \
+-t ./data/ligo_100.csv \
+-p ligo \
+-s cpop \
+--analytics summary
+echo "-------------------- LIGO 2000 with trace (spans only in builds with tracing) --------------------"
+$1/static_task_scheduling \
+-c ./data/large_cluster.csv \
+-t ./data/ligo_2000.csv \
+-p ligo \
+-s tdca \
+--trace ligo_2000_trace.json \
+--trace-tasks
 echo "-------------------- Missing topology (should error) --------------------"
 $1/static_task_scheduling \
 -c ./data/small_cluster.csv \
@@ -90,3 +239,9 @@ $1/static_task_scheduling \
 -t ./data/epigenome_100.csv \
 -p epigenome \
 -a ./data/example_assignment.csv
+echo "-------------------- Failing the only node (should error) --------------------"
+$1/static_task_scheduling \
+-c ./data/single_node_cluster.csv \
+-t ./data/example_task_bags.csv \
+-d ./data/example_dependencies.csv \
+--fail-node 0
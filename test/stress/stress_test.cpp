@@ -0,0 +1,237 @@
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include <scheduling/scheduler_context.hpp>
+
+// generates a workflow with about the given number of tasks from the task bags of a small workflow
+// of the same topology (and its dependencies for montage), schedules it once and fails if the
+// schedule is invalid or if the wall time or the peak resident set size exceed their baselines
+
+namespace {
+
+struct stress_parameters {
+    std::filesystem::path data_dir;
+    std::filesystem::path work_dir;
+    std::string topology;
+    size_t num_tasks;
+    std::string algorithm;
+    double max_seconds;
+    double max_rss_mb;
+};
+
+struct generated_workflow {
+    std::filesystem::path task_bag_input;
+    // only for montage, whose dependencies can't be inferred from the topology
+    std::filesystem::path dependency_input;
+};
+
+// the first 9 bags of montage: projections, differences of two overlapping projections, one
+// concatenation, one background model, one background correction per projection and a chain of
+// 4 single tasks, the projections don't send data to the background corrections in our model
+void write_montage_dependencies(std::filesystem::path const & path, std::vector<size_t> const & cardinalities) {
+    if (cardinalities.size() != 9 || cardinalities[0] != cardinalities[4]) {
+        throw std::runtime_error("The montage base workflow doesn't have the expected bags.");
+    }
+
+    std::vector<size_t> first_ids{0};
+    for (size_t const cardinality : cardinalities) {
+        first_ids.push_back(first_ids.back() + cardinality);
+    }
+
+    std::ofstream out(path, std::ios::trunc);
+    out << "# montage " << first_ids.back() << " task - generated\nfrom_id, to_id\n";
+
+    auto const add_edge = [&out] (size_t const from_id, size_t const to_id) {
+        out << from_id << ", " << to_id << '\n';
+    };
+
+    size_t const num_projections = cardinalities[0];
+
+    for (size_t j = 0; j < cardinalities[1]; ++j) {
+        size_t const first = j % num_projections;
+        size_t const second = (first + 1 + j / num_projections) % num_projections;
+
+        add_edge(first_ids[0] + first, first_ids[1] + j);
+        if (second != first) {
+            add_edge(first_ids[0] + second, first_ids[1] + j);
+        }
+
+        add_edge(first_ids[1] + j, first_ids[2]);
+    }
+
+    add_edge(first_ids[2], first_ids[3]);
+
+    for (size_t i = 0; i < cardinalities[4]; ++i) {
+        add_edge(first_ids[3], first_ids[4] + i);
+        add_edge(first_ids[4] + i, first_ids[5]);
+    }
+
+    for (size_t bag = 5; bag < 8; ++bag) {
+        add_edge(first_ids[bag], first_ids[bag + 1]);
+    }
+}
+
+// the bag with cardinality 1 stay single tasks, all other bags are scaled by the same factor,
+// so the one-to-one, distribute and aggregate patterns of the topology stay valid
+generated_workflow generate_workflow(stress_parameters const & params) {
+    std::string const base_name = params.topology == "montage"
+        ? "montage_1000.csv"
+        : params.topology + "_2000.csv";
+    std::ifstream in(params.data_dir / base_name);
+
+    if (!in) {
+        throw std::runtime_error("The base workflow " + base_name + " can't be opened.");
+    }
+
+    std::string comment{};
+    std::string header{};
+    std::getline(in, comment);
+    std::getline(in, header);
+
+    struct bag_row {
+        std::string values;
+        size_t cardinality;
+    };
+
+    std::vector<bag_row> rows{};
+    size_t num_base_tasks = 0;
+    size_t num_single_tasks = 0;
+
+    for (std::string line{}; std::getline(in, line);) {
+        if (line.empty()) {
+            continue;
+        }
+
+        size_t const separator = line.rfind(',');
+        size_t const cardinality = std::stoul(line.substr(separator + 1));
+        rows.push_back({line.substr(0, separator), cardinality});
+
+        num_base_tasks += cardinality;
+        if (cardinality == 1) {
+            ++num_single_tasks;
+        }
+    }
+
+    double const factor = static_cast<double>(params.num_tasks - num_single_tasks)
+        / static_cast<double>(num_base_tasks - num_single_tasks);
+
+    std::filesystem::create_directories(params.work_dir);
+    std::string const name = params.topology + '_' + std::to_string(params.num_tasks) + '_' + params.algorithm;
+    generated_workflow generated{params.work_dir / (name + ".csv"), {}};
+    std::ofstream out(generated.task_bag_input, std::ios::trunc);
+
+    out << "# " << params.topology << ' ' << params.num_tasks << " task - generated\n" << header << '\n';
+
+    std::vector<size_t> cardinalities{};
+
+    for (bag_row const & row : rows) {
+        size_t const cardinality = row.cardinality == 1
+            ? 1
+            : static_cast<size_t>(std::llround(static_cast<double>(row.cardinality) * factor));
+
+        out << row.values << ", " << cardinality << '\n';
+        cardinalities.push_back(cardinality);
+    }
+
+    if (params.topology == "montage") {
+        generated.dependency_input = params.work_dir / (name + "_dependencies.csv");
+        write_montage_dependencies(generated.dependency_input, cardinalities);
+    }
+
+    return generated;
+}
+
+// in MiB, ru_maxrss is given in bytes on macOS and in KiB everywhere else
+double peak_rss_mb() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+
+#ifdef __APPLE__
+    return static_cast<double>(usage.ru_maxrss) / (1024.0 * 1024.0);
+#else
+    return static_cast<double>(usage.ru_maxrss) / 1024.0;
+#endif
+}
+
+int run(stress_parameters const & params) {
+    generated_workflow const generated = generate_workflow(params);
+
+    auto const start = std::chrono::steady_clock::now();
+
+    scheduling::scheduler_context context((params.data_dir / "large_cluster.csv").string());
+    scheduling::workflow_handle const handle = context.load_workflow(
+        generated.task_bag_input.string(),
+        params.topology,
+        generated.dependency_input.string()
+    );
+    scheduling::schedule_result const & result = context.schedule(handle, params.algorithm);
+
+    auto const end = std::chrono::steady_clock::now();
+
+    double const seconds = std::chrono::duration<double>(end - start).count();
+    double const rss_mb = peak_rss_mb();
+    std::filesystem::remove(generated.task_bag_input);
+    if (!generated.dependency_input.empty()) {
+        std::filesystem::remove(generated.dependency_input);
+    }
+
+    std::cout << params.topology << ' ' << context.num_tasks(handle) << " tasks, " << result.algorithm
+        << ": makespan " << result.makespan
+        << ", " << seconds << " s (baseline " << params.max_seconds << " s)"
+        << ", peak rss " << rss_mb << " MiB (baseline " << params.max_rss_mb << " MiB)\n";
+
+    int exit_code = 0;
+
+    if (!result.valid) {
+        std::cout << "FAILED: the schedule is not valid\n";
+        exit_code = 1;
+    }
+
+    if (seconds > params.max_seconds) {
+        std::cout << "FAILED: the wall time exceeds its baseline\n";
+        exit_code = 1;
+    }
+
+    if (rss_mb > params.max_rss_mb) {
+        std::cout << "FAILED: the peak resident set size exceeds its baseline\n";
+        exit_code = 1;
+    }
+
+    return exit_code;
+}
+
+} // namespace
+
+int main(int argc, char * argv[]) {
+    if (argc != 8) {
+        std::cerr << "usage: " << argv[0]
+            << " <data_dir> <work_dir> <topology> <num_tasks> <algorithm> <max_seconds> <max_rss_mb>\n";
+        return 2;
+    }
+
+    try {
+        return run({
+            argv[1],
+            argv[2],
+            argv[3],
+            std::stoul(argv[4]),
+            argv[5],
+            std::stod(argv[6]),
+            std::stod(argv[7])
+        });
+    } catch (std::exception const & e) {
+        std::cout << "FAILED: " << e.what() << '\n';
+        return 1;
+    }
+}
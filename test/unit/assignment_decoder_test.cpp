@@ -0,0 +1,156 @@
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cluster/cluster.hpp>
+#include <cluster/cost_model.hpp>
+#include <io/read_cluster_input.hpp>
+#include <io/read_csv.hpp>
+#include <io/read_workflow_input.hpp>
+#include <schedule/assignment_decoder.hpp>
+#include <schedule/from_assignment.hpp>
+#include <workflow/workflow.hpp>
+
+// the makespans of the assignment decoder must be bit-identical to the makespans of the schedules
+// that from_assignment builds, for the example assignment and for seeded random assignments on
+// every cost model, one decoder evaluates all assignments of a workflow to also cover its reuse
+
+namespace {
+
+struct decoder_case {
+    std::string name;
+    std::string cluster_input;
+    std::string rack_input;
+    std::string link_input;
+    std::string task_bag_input;
+    std::string topology;
+    std::string dependency_input;
+    std::string assignment_input;
+    size_t num_random_assignments;
+};
+
+workflow::workflow read_workflow(decoder_case const & test_case) {
+    io::workflow_input input = io::read_workflow_input(
+        test_case.task_bag_input,
+        test_case.topology,
+        test_case.dependency_input
+    );
+
+    return workflow::workflow(
+        std::move(input.tasks),
+        std::move(input.input_data_sizes),
+        std::move(input.output_data_sizes),
+        std::move(input.dependencies),
+        std::move(input.task_ids_per_bag)
+    );
+}
+
+// the number of mismatching assignments
+size_t run(decoder_case const & test_case) {
+    cluster::cluster const c = io::read_cluster_input(
+        test_case.cluster_input,
+        test_case.rack_input,
+        test_case.link_input,
+        std::nullopt
+    );
+    workflow::workflow const w = read_workflow(test_case);
+
+    std::vector<std::vector<cluster::node_id>> assignments{};
+
+    if (!test_case.assignment_input.empty()) {
+        assignments.push_back(io::read_task_to_node_assignment_csv(test_case.assignment_input, w.size(), c.size()));
+    }
+
+    // fixed seed, so every run checks the same assignments
+    std::mt19937_64 generator(42);
+    std::uniform_int_distribution<cluster::node_id> node_distribution(0, c.size() - 1);
+
+    for (size_t i = 0; i < test_case.num_random_assignments; ++i) {
+        std::vector<cluster::node_id> & assignment = assignments.emplace_back(w.size());
+
+        for (cluster::node_id & n_id : assignment) {
+            n_id = node_distribution(generator);
+        }
+    }
+
+    size_t num_mismatches = 0;
+
+    cluster::visit_cost_model(c, [&] <cluster::cost_model M> ([[maybe_unused]] M const & model) {
+        schedule::assignment_decoder<M> decoder(c, w);
+
+        for (size_t i = 0; i < assignments.size(); ++i) {
+            util::timepoint const decoded = decoder.makespan(assignments[i]);
+            util::timepoint const expected = schedule::from_assignment<M>(assignments[i], c, w, false).get_makespan();
+
+            if (decoded != expected) {
+                std::cout << "FAILED: " << test_case.name << ", assignment " << i << ": decoded makespan "
+                    << decoded << ", makespan of from_assignment " << expected << '\n';
+                ++num_mismatches;
+            }
+        }
+    });
+
+    std::cout << test_case.name << ": " << assignments.size() << " assignments, "
+        << num_mismatches << " mismatches\n";
+
+    return num_mismatches;
+}
+
+} // namespace
+
+int main(int argc, char * argv[]) {
+    if (argc != 2) {
+        std::cerr << "usage: " << argv[0] << " <data_dir>\n";
+        return 2;
+    }
+
+    std::cout.precision(std::numeric_limits<double>::max_digits10);
+    std::filesystem::path const data_dir = argv[1];
+
+    auto const data = [&data_dir] (std::string const & filename) {
+        return (data_dir / filename).string();
+    };
+
+    std::vector<decoder_case> const test_cases = {
+        {
+            "example", data("example_cluster.csv"), "", "", data("example_task_bags.csv"), "",
+            data("example_dependencies.csv"), data("example_assignment.csv"), 20
+        },
+        {
+            "example with links", data("example_cluster.csv"), "", data("example_links.csv"),
+            data("example_task_bags.csv"), "", data("example_dependencies.csv"), data("example_assignment.csv"), 20
+        },
+        {"ligo 100", data("small_cluster.csv"), "", "", data("ligo_100.csv"), "ligo", "", "", 20},
+        {"cybershake 100", data("small_cluster.csv"), "", "", data("cybershake_100.csv"), "cybershake", "", "", 20},
+        {"epigenome 100", data("small_cluster.csv"), "", "", data("epigenome_100.csv"), "epigenome", "", "", 20},
+        {
+            "epigenome 100 with node bandwidths", data("mixed_bandwidth_cluster.csv"), "", "",
+            data("epigenome_100.csv"), "epigenome", "", "", 20
+        },
+        {"ligo 2000", data("large_cluster.csv"), "", "", data("ligo_2000.csv"), "ligo", "", "", 5},
+        {
+            "cybershake 2000 with racks", data("large_cluster.csv"), data("large_cluster_racks.csv"), "",
+            data("cybershake_2000.csv"), "cybershake", "", "", 5
+        }
+    };
+
+    size_t num_mismatches = 0;
+
+    try {
+        for (decoder_case const & test_case : test_cases) {
+            num_mismatches += run(test_case);
+        }
+    } catch (std::exception const & e) {
+        std::cout << "FAILED: " << e.what() << '\n';
+        return 1;
+    }
+
+    return num_mismatches == 0 ? 0 : 1;
+}
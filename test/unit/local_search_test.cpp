@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <algorithms/algorithm.hpp>
+#include <algorithms/algorithm_options.hpp>
+#include <cluster/cluster.hpp>
+#include <cluster/cost_model.hpp>
+#include <io/read_cluster_input.hpp>
+#include <io/read_workflow_input.hpp>
+#include <schedule/from_assignment.hpp>
+#include <schedule/local_search.hpp>
+#include <workflow/workflow.hpp>
+
+// after every round of random moves, the makespan of the incremental evaluation of the local search
+// must be bit-identical to the makespan of its solution rebuilt from scratch, i.e. every node runs
+// its tasks in key order as early as possible, the schedule of the solution must be valid and
+// must not be longer, from_assignment with the same nodes must also give a valid schedule
+
+namespace {
+
+struct local_search_case {
+    std::string name;
+    std::string cluster_input;
+    std::string rack_input;
+    std::string link_input;
+    std::string task_bag_input;
+    std::string topology;
+    std::string dependency_input;
+    size_t num_rounds;
+    size_t iterations_per_round;
+};
+
+workflow::workflow read_workflow(local_search_case const & test_case) {
+    io::workflow_input input = io::read_workflow_input(
+        test_case.task_bag_input,
+        test_case.topology,
+        test_case.dependency_input
+    );
+
+    return workflow::workflow(
+        std::move(input.tasks),
+        std::move(input.input_data_sizes),
+        std::move(input.output_data_sizes),
+        std::move(input.dependencies),
+        std::move(input.task_ids_per_bag)
+    );
+}
+
+// the makespan of the solution computed from scratch in key order
+template <cluster::cost_model M>
+util::timepoint rebuilt_makespan(
+    cluster::cluster const & c,
+    workflow::workflow const & w,
+    std::vector<cluster::node_id> const & assignment,
+    std::vector<workflow::task_id> const & key_order
+) {
+    M const model(c);
+    std::vector<util::timepoint> finish_times(w.size(), 0.0);
+    std::vector<util::timepoint> node_finish_times(c.size(), 0.0);
+    util::timepoint makespan = 0.0;
+
+    for (workflow::task_id const t_id : key_order) {
+        cluster::node_id const n_id = assignment[t_id];
+        util::timepoint ready_time = 0.0;
+
+        for (auto const & [pred_id, data_transfer] : w.get_task_incoming_edges(t_id)) {
+            ready_time = std::max(
+                ready_time,
+                finish_times[pred_id] + model.data_transfer_cost(data_transfer, assignment[pred_id], n_id)
+            );
+        }
+
+        ready_time = std::max(ready_time, node_finish_times[n_id]);
+        finish_times[t_id] = ready_time + model.computation_time(w.get_task(t_id).workload, n_id);
+        node_finish_times[n_id] = finish_times[t_id];
+        makespan = std::max(makespan, finish_times[t_id]);
+    }
+
+    return makespan;
+}
+
+// the number of failed rounds
+size_t run(local_search_case const & test_case) {
+    cluster::cluster const c = io::read_cluster_input(
+        test_case.cluster_input,
+        test_case.rack_input,
+        test_case.link_input,
+        std::nullopt
+    );
+    workflow::workflow const w = read_workflow(test_case);
+
+    size_t num_failures = 0;
+    size_t num_accepted_moves = 0;
+
+    cluster::visit_cost_model(c, [&] <cluster::cost_model M> ([[maybe_unused]] M const & model) {
+        schedule::schedule<M> const initial = algorithms::to_function<M>(
+            algorithms::algorithm::HEFT, c, w, algorithms::algorithm_options{}
+        )();
+        schedule::local_search<M> search(initial, c, w, false);
+
+        for (size_t round = 0; round < test_case.num_rounds; ++round) {
+            // a different seed per round, so the rounds don't repeat the same moves
+            schedule::local_search_budget const budget{0, test_case.iterations_per_round, round + 1};
+            num_accepted_moves += search.run(budget).num_accepted_moves;
+
+            util::timepoint const evaluated = search.get_makespan();
+            util::timepoint const rebuilt = rebuilt_makespan<M>(
+                c, w, search.get_assignment(), search.get_key_order()
+            );
+            schedule::schedule<M> const s = search.to_schedule();
+            schedule::schedule<M> const assigned = schedule::from_assignment<M>(
+                search.get_assignment(), c, w, false
+            );
+
+            if (
+                evaluated != rebuilt
+                || !s.is_valid(w)
+                || s.get_makespan() > evaluated
+                || !assigned.is_valid(w)
+            ) {
+                std::cout << "FAILED: " << test_case.name << ", round " << round << ": evaluated makespan "
+                    << evaluated << ", rebuilt makespan " << rebuilt << ", schedule makespan "
+                    << s.get_makespan() << '\n';
+                ++num_failures;
+            }
+        }
+    });
+
+    std::cout << test_case.name << ": " << test_case.num_rounds << " rounds, " << num_accepted_moves
+        << " accepted moves, " << num_failures << " failed rounds\n";
+
+    return num_failures;
+}
+
+} // namespace
+
+int main(int argc, char * argv[]) {
+    if (argc != 2) {
+        std::cerr << "usage: " << argv[0] << " <data_dir>\n";
+        return 2;
+    }
+
+    std::cout.precision(std::numeric_limits<double>::max_digits10);
+    std::filesystem::path const data_dir = argv[1];
+
+    auto const data = [&data_dir] (std::string const & filename) {
+        return (data_dir / filename).string();
+    };
+
+    std::vector<local_search_case> const test_cases = {
+        {
+            "example", data("example_cluster.csv"), "", "", data("example_task_bags.csv"), "",
+            data("example_dependencies.csv"), 20, 50
+        },
+        {
+            "example with links", data("example_cluster.csv"), "", data("example_links.csv"),
+            data("example_task_bags.csv"), "", data("example_dependencies.csv"), 20, 50
+        },
+        {"ligo 100", data("small_cluster.csv"), "", "", data("ligo_100.csv"), "ligo", "", 20, 200},
+        {"cybershake 100", data("small_cluster.csv"), "", "", data("cybershake_100.csv"), "cybershake", "", 20, 200},
+        {"epigenome 100", data("small_cluster.csv"), "", "", data("epigenome_100.csv"), "epigenome", "", 20, 200},
+        {
+            "epigenome 100 with node bandwidths", data("mixed_bandwidth_cluster.csv"), "", "",
+            data("epigenome_100.csv"), "epigenome", "", 20, 200
+        },
+        {"ligo 2000", data("large_cluster.csv"), "", "", data("ligo_2000.csv"), "ligo", "", 10, 1000},
+        {
+            "cybershake 2000 with racks", data("large_cluster.csv"), data("large_cluster_racks.csv"), "",
+            data("cybershake_2000.csv"), "cybershake", "", 10, 1000
+        }
+    };
+
+    size_t num_failures = 0;
+
+    try {
+        for (local_search_case const & test_case : test_cases) {
+            num_failures += run(test_case);
+        }
+    } catch (std::exception const & e) {
+        std::cout << "FAILED: " << e.what() << '\n';
+        return 1;
+    }
+
+    return num_failures == 0 ? 0 : 1;
+}